@@ -0,0 +1,142 @@
+#include <chrono>
+#include <string_view>
+#include <unordered_map>
+
+#include "ApiDiff.h"
+#include "CrossReference.h"
+#include "Hash.h"
+#include "Log.h"
+#include "Phase.h"
+#include "RunReport.h"
+#include "Writer.h"
+
+/* Continues hash over field, followed by a separator so that adjacent fields cannot run into each other. */
+static uint64_t HashField(const uint64_t hash, std::string_view field)
+{
+	const char separator = '\0';
+	return Hash::Of(&separator, 1, Hash::Of(field.data(), field.length(), hash));
+}
+
+ApiDiff::Fingerprint ApiDiff::Of(const MW& mw)
+{
+	Fingerprint fingerprint = { Hash::Of(nullptr, 0), Hash::Of(nullptr, 0) };
+
+	uint64_t& signature = fingerprint.signature;
+	signature = HashField(signature, mw.mw_type);
+	signature = HashField(signature, mw.implicit);
+
+	for (auto& decoration : mw.decorations)
+		signature = HashField(signature, decoration);
+
+	for (size_t i = 0; i < mw.type_count; ++i)
+		signature = HashField(signature, mw.ParameterType(i));
+
+	for (size_t i = 0; i < mw.name_count; ++i)
+		signature = HashField(signature, mw.ParameterName(i));
+
+	uint64_t& documentation = fingerprint.documentation;
+	documentation = HashField(documentation, mw.summary);
+	documentation = HashField(documentation, mw.remarks);
+	documentation = HashField(documentation, mw.returns);
+
+	for (size_t i = 0; i < mw.name_count; ++i)
+		documentation = HashField(documentation, mw.ParameterDescription(i));
+
+	for (auto& cref : mw.see_also)
+		documentation = HashField(documentation, cref);
+
+	return fingerprint;
+}
+
+ApiChanges ApiDiff::Compute(const VT(MW)& before, const VT(MW)& after)
+{
+	ApiChanges changes;
+
+	std::unordered_map<std::string_view, size_t> index;
+	index.reserve(before.size());
+
+	for (size_t i = 0; i < before.size(); ++i)
+	{
+		index.emplace(before[i].doc_id, i);
+	}
+
+	VT(bool) matched(before.size(), false);
+
+	for (const MW& mw : after)
+	{
+		auto found = index.find(mw.doc_id);
+		if (found == index.end())
+		{
+			changes.added.push_back(&mw);
+			continue;
+		}
+
+		const MW& old = before[found->second];
+		matched[found->second] = true;
+
+		const Fingerprint was = Of(old), is = Of(mw);
+		if (was.signature != is.signature || was.documentation != is.documentation)
+			changes.changed.push_back({ &old, &mw, was.signature != is.signature, was.documentation != is.documentation });
+	}
+
+	for (size_t i = 0; i < before.size(); ++i)
+	{
+		if (!matched[i])
+			changes.removed.push_back(&before[i]);
+	}
+
+	return changes;
+}
+
+bool ApiDiff::WriteChangelog(const VT(MW)& before, const VT(MW)& after, const VT(Writer*)& backends, OutputSink& sink)
+{
+	ApiChanges changes;
+
+	{
+		PhaseScope process(EPhase::Process);
+
+		const auto start = std::chrono::steady_clock::now();
+		changes = Compute(before, after);
+		const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+		MLOG(Info, "Diffed " << before.size() << " against " << after.size() << " members in " << elapsed.count() / 1000.0 << " ms: "
+			<< changes.added.size() << " added, " << changes.removed.size() << " removed, " << changes.changed.size() << " changed.");
+
+		RunReport::Set("diff", "{\"before\":" + std::to_string(before.size()) + ",\"after\":" + std::to_string(after.size())
+			+ ",\"added\":" + std::to_string(changes.added.size()) + ",\"removed\":" + std::to_string(changes.removed.size())
+			+ ",\"changed\":" + std::to_string(changes.changed.size()) + ",\"microseconds\":" + std::to_string(elapsed.count()) + "}");
+	}
+
+	// Links in the changelog point at the pages of the newer version.
+	CrossReference crefs;
+	crefs.Build(after);
+
+	bool written = true;
+	for (Writer* backend : backends)
+	{
+		written &= backend->WriteChangelog(changes, crefs, sink);
+	}
+
+	return written;
+}
+
+std::string ApiDiff::Title(const MW& mw)
+{
+	const size_t colon = mw.doc_id.find(':');
+	return colon != std::string::npos ? mw.doc_id.substr(colon + 1) : mw.doc_id;
+}
+
+const char* ApiDiff::Kind(const MW& mw)
+{
+	switch (mw.doc_id.length() > 1 && mw.doc_id[1] == ':' ? mw.doc_id[0] : '\0')
+	{
+	case 'T': return "Type";
+	case 'M': return "Method";
+	case 'P': return "Property";
+	case 'F': return "Field";
+	case 'E': return "Event";
+	case 'N': return "Namespace";
+	}
+
+	return "Member";
+}
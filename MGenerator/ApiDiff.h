@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "MW.h"
+#include "MMacros.h"
+
+class OutputSink;
+class Writer;
+
+/*
+* A member documented in both versions of MW.xml whose signature or documentation differs.
+*/
+struct ApiChange
+{
+	const MW* before;
+	const MW* after;
+
+	// The type, decorations or parameters differ.
+	bool signature;
+	// The summary, remarks, returns, parameter descriptions or <seealso>s differ.
+	bool documentation;
+};
+
+/*
+* Every difference between two versions of MW.xml, each in the order Reader sorts members.
+*/
+struct ApiChanges
+{
+	// Only in the newer version.
+	VT(const MW*) added;
+	// Only in the older version.
+	VT(const MW*) removed;
+	VT(ApiChange) changed;
+};
+
+/*
+* Compares two parses of MW.xml, for release notes.
+* Members are matched by MW::doc_id with a single hash lookup each, and compared by
+  fingerprint, so a diff is linear in the number of members.
+*/
+class ApiDiff
+{
+
+public:
+
+	struct Fingerprint
+	{
+		uint64_t signature;
+		uint64_t documentation;
+	};
+
+	/* The changes from before to after. Both must outlive the result. */
+	static ApiChanges Compute(const VT(MW)& before, const VT(MW)& after);
+
+	static Fingerprint Of(const MW& mw);
+
+	/*
+	* Diffs before against after and writes the changelog page of every backend to sink.
+	* Returns false if a changelog could not be written.
+	*/
+	static bool WriteChangelog(const VT(MW)& before, const VT(MW)& after, const VT(Writer*)& backends, OutputSink& sink);
+
+	/* doc_id without its kind prefix. E.g., MW.MArray`1.Push(`0). */
+	static std::string Title(const MW& mw);
+
+	/* The kind of member from the prefix of doc_id. E.g., Method for M:. */
+	static const char* Kind(const MW& mw);
+
+};
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/*
+* How full a BoundedQueue was while it was used.
+*/
+struct QueueStats
+{
+	size_t capacity = 0;
+	size_t pushes = 0;
+	// The sum and the largest number of items queued, sampled after every push.
+	size_t occupancy_sum = 0;
+	size_t occupancy_max = 0;
+	// The number of times a push found the queue full, or a pop found it empty.
+	size_t full_waits = 0;
+	size_t empty_waits = 0;
+
+	double MeanOccupancy() const { return pushes != 0 ? static_cast<double>(occupancy_sum) / pushes : 0.0; }
+};
+
+/*
+* A bounded, lock-free, multi-producer multi-consumer queue that connects two stages of
+  a pipeline.
+* Every cell carries a sequence number that says whether it is ready to be written or
+  read for the current lap of the ring, so a push or pop is a single compare-and-swap.
+* A push to a full queue, or a pop from an empty one, backs off until the other stage
+  catches up. A stage whose input is usually full is slower than the stage feeding it.
+*/
+template <typename T>
+class BoundedQueue
+{
+
+public:
+
+	/* capacity is rounded up to a power of two. */
+	explicit BoundedQueue(const size_t capacity)
+	{
+		size_t size = 2;
+		while (size < capacity)
+		{
+			size <<= 1;
+		}
+
+		cells = std::vector<Cell>(size);
+		mask = size - 1;
+
+		for (size_t i = 0; i < size; ++i)
+		{
+			cells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	BoundedQueue(const BoundedQueue&) = delete;
+	BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+	/* Moves value into the queue, waiting while it is full. */
+	void Push(T value)
+	{
+		if (!TryPush(value))
+		{
+			full_waits.fetch_add(1, std::memory_order_relaxed);
+
+			for (unsigned spins = 0; !TryPush(value); ++spins)
+			{
+				Backoff(spins);
+			}
+		}
+
+		pushes.fetch_add(1, std::memory_order_relaxed);
+
+		const size_t occupancy = Size();
+		occupancy_sum.fetch_add(occupancy, std::memory_order_relaxed);
+
+		size_t max = occupancy_max.load(std::memory_order_relaxed);
+		while (occupancy > max && !occupancy_max.compare_exchange_weak(max, occupancy, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	/*
+	* Moves the oldest item into value, waiting while the queue is empty.
+	* Returns false once the queue is closed and empty.
+	*/
+	bool Pop(T& value)
+	{
+		if (TryPop(value))
+			return true;
+
+		empty_waits.fetch_add(1, std::memory_order_relaxed);
+
+		for (unsigned spins = 0;; ++spins)
+		{
+			// Everything pushed before Close is visible once closed is.
+			const bool is_closed = closed.load(std::memory_order_acquire);
+
+			if (TryPop(value))
+				return true;
+
+			if (is_closed)
+				return false;
+
+			Backoff(spins);
+		}
+	}
+
+	/* Called by the producing stage once it has pushed everything. */
+	void Close() { closed.store(true, std::memory_order_release); }
+
+	size_t Capacity() const { return cells.size(); }
+
+	/* The number of items queued. Approximate while other threads push or pop. */
+	size_t Size() const
+	{
+		const size_t enqueued = enqueue_position.load(std::memory_order_relaxed);
+		const size_t dequeued = dequeue_position.load(std::memory_order_relaxed);
+		return enqueued > dequeued ? enqueued - dequeued : 0;
+	}
+
+	QueueStats Stats() const
+	{
+		QueueStats stats;
+		stats.capacity = Capacity();
+		stats.pushes = pushes.load();
+		stats.occupancy_sum = occupancy_sum.load();
+		stats.occupancy_max = occupancy_max.load();
+		stats.full_waits = full_waits.load();
+		stats.empty_waits = empty_waits.load();
+		return stats;
+	}
+
+private:
+
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	bool TryPush(T& value)
+	{
+		size_t position = enqueue_position.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &cells[position & mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+			if (lap == 0)
+			{
+				if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (lap < 0)
+			{
+				// Full.
+				return false;
+			}
+			else
+			{
+				position = enqueue_position.load(std::memory_order_relaxed);
+			}
+		}
+
+		cell->value = std::move(value);
+		cell->sequence.store(position + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	bool TryPop(T& value)
+	{
+		size_t position = dequeue_position.load(std::memory_order_relaxed);
+		Cell* cell;
+
+		for (;;)
+		{
+			cell = &cells[position & mask];
+			const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			const intptr_t lap = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+			if (lap == 0)
+			{
+				if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if (lap < 0)
+			{
+				// Empty.
+				return false;
+			}
+			else
+			{
+				position = dequeue_position.load(std::memory_order_relaxed);
+			}
+		}
+
+		value = std::move(cell->value);
+		cell->sequence.store(position + mask + 1, std::memory_order_release);
+
+		return true;
+	}
+
+	/* Yields for a while, then sleeps, so that a stage waiting on a slow neighbour does not take a core. */
+	static void Backoff(const unsigned spins)
+	{
+		if (spins < 64)
+			std::this_thread::yield();
+		else
+			std::this_thread::sleep_for(std::chrono::microseconds(50));
+	}
+
+	std::vector<Cell> cells;
+	size_t mask;
+
+	// On separate cache lines, so producers and consumers do not contend.
+	alignas(64) std::atomic<size_t> enqueue_position{ 0 };
+	alignas(64) std::atomic<size_t> dequeue_position{ 0 };
+	alignas(64) std::atomic<bool> closed{ false };
+
+	std::atomic<size_t> pushes{ 0 };
+	std::atomic<size_t> occupancy_sum{ 0 };
+	std::atomic<size_t> occupancy_max{ 0 };
+	std::atomic<size_t> full_waits{ 0 };
+	std::atomic<size_t> empty_waits{ 0 };
+
+};
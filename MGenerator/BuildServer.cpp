@@ -0,0 +1,365 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <unordered_set>
+
+#include "BuildServer.h"
+#include "ApiDiff.h"
+#include "CrossReference.h"
+#include "JSON.h"
+#include "Lint.h"
+#include "Log.h"
+#include "Manifest.h"
+#include "OutputSink.h"
+#include "Pipeline.h"
+#include "Reader.h"
+#include "RunReport.h"
+#include "Socket.h"
+#include "SwapChars.h"
+#include "Writer.h"
+
+BuildServer::BuildServer(const VT(Writer*)& backends, const Options& options)
+	: backends(backends), options(options), parameters(new ParameterStore), written(backends.size()), indexes(backends.size()), requests(0)
+{
+}
+
+int BuildServer::Run(const std::string& socket_path)
+{
+	if (!Socket::Start())
+	{
+		MLOG(Error, "Failed to start Winsock.");
+		return -1;
+	}
+
+	sockaddr_un address;
+	if (!Socket::UnixAddress(socket_path, address))
+	{
+		MLOG(Error, "The socket path " << socket_path << " is too long.");
+		return -1;
+	}
+
+	// A socket file left behind by a daemon that was killed is removed; a live daemon is not replaced.
+	std::string ignored;
+	if (Send(socket_path, "", ignored))
+	{
+		MLOG(Error, "A daemon is already listening on " << socket_path << '.');
+		return -1;
+	}
+
+	std::error_code error;
+	std::filesystem::remove(socket_path, error);
+
+	socket_t listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (listener == INVALID_SOCKET)
+	{
+		MLOG(Error, "Failed to create the daemon's socket.");
+		return -1;
+	}
+
+	if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 4) != 0)
+	{
+		MLOG(Error, "Failed to listen on " << socket_path << ". Maybe permissions?");
+		CloseSocket(listener);
+		return -1;
+	}
+
+	MLOG(Info, "Waiting for builds on " << socket_path << '.');
+
+	for (bool stopping = false; !stopping;)
+	{
+		socket_t client = accept(listener, nullptr, nullptr);
+		if (client == INVALID_SOCKET)
+			continue;
+
+		std::string request;
+		char c;
+		while (request.length() < 64 * 1024 && recv(client, &c, 1, 0) == 1 && c != '\n')
+		{
+			request += c;
+		}
+
+		std::string reply;
+		if (request.compare(0, 9, "generate ") == 0)
+		{
+			reply = Generate(request.substr(9));
+		}
+		else if (request == "stop")
+		{
+			reply = "{\"stopped\":true}";
+			stopping = true;
+		}
+		else if (request.length() != 0)
+		{
+			reply = "{\"error\":" + JSON::Quote("Unknown request: " + request) + '}';
+		}
+
+		Socket::SendAll(client, reply + '\n');
+		CloseSocket(client);
+	}
+
+	CloseSocket(listener);
+	std::filesystem::remove(socket_path, error);
+
+	MLOG(Info, "Stopped after " << requests << " builds.");
+
+	return 0;
+}
+
+bool BuildServer::Send(const std::string& socket_path, const std::string& request, std::string& reply)
+{
+	sockaddr_un address;
+	if (!Socket::Start() || !Socket::UnixAddress(socket_path, address))
+		return false;
+
+	socket_t server = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (server == INVALID_SOCKET)
+		return false;
+
+	if (connect(server, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+	{
+		CloseSocket(server);
+		return false;
+	}
+
+	const bool sent = Socket::SendAll(server, request + '\n');
+	if (sent)
+		Socket::ReceiveAll(server, reply);
+
+	CloseSocket(server);
+
+	return sent;
+}
+
+std::string BuildServer::Generate(const std::string& input)
+{
+	using Clock = std::chrono::steady_clock;
+	auto Milliseconds = [](Clock::time_point from, Clock::time_point to) { return std::chrono::duration<double, std::milli>(to - from).count(); };
+
+	const Clock::time_point start = Clock::now();
+	++requests;
+
+	// A missing or malformed MW.xml fails this build, not the daemon. The last parse is kept, so
+	// the next build is still diffed against what was last written.
+	std::unique_ptr<ParameterStore> next_parameters(new ParameterStore);
+	VT(MW) next_mw;
+	std::string error;
+	if (!Reader::Read(input, options.Stages(), *next_parameters, options.parser, next_mw, error))
+	{
+		MLOG(Error, error);
+		return "{\"input\":" + JSON::Quote(input) + ",\"request\":" + std::to_string(requests) + ",\"error\":" + JSON::Quote(error) + '}';
+	}
+
+	const Clock::time_point read = Clock::now();
+
+	const VT(LintFinding) findings = Lint::Run(next_mw, options.Threads());
+	if (options.lint_json.length() != 0)
+	{
+		if (!Lint::WriteJSON(findings, options.lint_json))
+			MLOG(Error, "Failed to write lint findings to " << options.lint_json);
+	}
+	else
+	{
+		Lint::Print(findings);
+	}
+
+	const Clock::time_point linted = Clock::now();
+
+	// Added or removed members change navigation and which crefs resolve, on any page, so every
+	// page is rendered again. Otherwise, only the pages of changed members can differ.
+	const ApiChanges changes = ApiDiff::Compute(all_mw, next_mw);
+	const bool restructured = !changes.added.empty() || !changes.removed.empty();
+
+	std::unordered_set<std::string> dirty;
+	for (const ApiChange& change : changes.changed)
+	{
+		dirty.insert(change.after->mw_namespace);
+	}
+
+	CrossReference crefs;
+	crefs.Build(next_mw);
+	const Site site = Writer::Paginate(next_mw);
+
+	struct Task
+	{
+		size_t backend;
+		size_t page;
+		std::string content;
+	};
+
+	VT(Task) tasks;
+	for (size_t b = 0; b < backends.size(); ++b)
+	{
+		for (size_t p = 0; p < site.pages.size(); ++p)
+		{
+			if (restructured || dirty.count(site.pages[p].name) != 0)
+				tasks.push_back({ b, p, std::string() });
+		}
+	}
+
+	std::atomic<size_t> next_task{ 0 };
+	auto RenderPages = [&]()
+	{
+		for (size_t t = next_task++; t < tasks.size(); t = next_task++)
+		{
+			tasks[t].content = backends[tasks[t].backend]->Render(site.pages[tasks[t].page], site, crefs);
+		}
+	};
+
+	VT(std::thread) renderers;
+	for (size_t r = 0; r < std::min<size_t>(std::max(1u, options.Stages().render), tasks.size()); ++r)
+	{
+		renderers.emplace_back(RenderPages);
+	}
+
+	for (auto& renderer : renderers)
+	{
+		renderer.join();
+	}
+
+	const Clock::time_point rendered = Clock::now();
+
+	// Only pages whose content differs from what was last written are written again.
+	const std::unique_ptr<OutputSink> sink = OutputSink::Create(options.sink);
+	VT(std::string) changed_files, stale_files;
+	bool failed = false;
+
+	for (Task& task : tasks)
+	{
+		const Page& page = site.pages[task.page];
+		std::string& last = written[task.backend][page.name];
+
+		if (last == task.content)
+			continue;
+
+		// A page that could not be written is tried again by the next request.
+		Writer* backend = backends[task.backend];
+		if (backend->WritePage(page, std::string(task.content), *sink, nullptr))
+		{
+			last = std::move(task.content);
+			changed_files.push_back(backend->OutputPath() + page.name + backend->Extension());
+		}
+		else
+		{
+			failed = true;
+
+			if (last.empty())
+				written[task.backend].erase(page.name);
+		}
+	}
+
+	// An index is about which pages exist, so it can only change when they do.
+	for (size_t b = 0; restructured && b < backends.size(); ++b)
+	{
+		Writer* backend = backends[b];
+
+		MemorySink index;
+		if (!backend->WriteIndex(site, index, nullptr))
+		{
+			failed = true;
+			continue;
+		}
+
+		for (auto& file : index.Pages())
+		{
+			std::string& last = indexes[b][file.first.substr(backend->OutputPath().length())];
+			if (last == file.second)
+				continue;
+
+			if (sink->Write(file.first, file.second))
+			{
+				last = file.second;
+				changed_files.push_back(file.first);
+			}
+			else
+			{
+				MLOG(Error, "Failed to write the " << backend->Name() << " index to " << file.first << ". Maybe permissions?");
+				failed = true;
+			}
+		}
+	}
+
+	for (size_t b = 0; b < backends.size(); ++b)
+	{
+		// Pages of namespaces that no longer exist are left on disk, as a normal run does,
+		// and are listed as removed by the manifest diff.
+		for (auto page = written[b].begin(); page != written[b].end();)
+		{
+			// site.pages is sorted by name.
+			auto found = std::lower_bound(site.pages.begin(), site.pages.end(), page->first, [](const Page& p, const std::string& n) { return p.name < n; });
+
+			if (found != site.pages.end() && found->name == page->first)
+			{
+				++page;
+				continue;
+			}
+
+			stale_files.push_back(backends[b]->OutputPath() + page->first + backends[b]->Extension());
+			page = written[b].erase(page);
+		}
+
+		if (sink->IsPersistent())
+		{
+			Manifest manifest(backends[b]->OutputPath());
+			for (auto& page : written[b])
+			{
+				manifest.Add(page.first + backends[b]->Extension(), { "MW." + page.first }, page.second);
+			}
+
+			for (auto& index : indexes[b])
+			{
+				manifest.Add(index.first, {}, index.second);
+			}
+
+			manifest.Finish(backends[b]->Name());
+		}
+	}
+
+	const Clock::time_point wrote = Clock::now();
+
+	// The new parse is kept for the next request; the old one is only released now, as
+	// changes pointed into it.
+	parameters = std::move(next_parameters);
+	all_mw = std::move(next_mw);
+
+	auto AppendFiles = [](std::string& json, const VT(std::string)& files)
+	{
+		json += '[';
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			if (i != 0)
+				json += ',';
+
+			JSON::AppendString(json, files[i]);
+		}
+		json += ']';
+	};
+
+	std::string reply = "{\"input\":" + JSON::Quote(input) + ",\"request\":" + std::to_string(requests)
+		+ ",\"members\":" + std::to_string(all_mw.size()) + ",\"added\":" + std::to_string(changes.added.size())
+		+ ",\"removed\":" + std::to_string(changes.removed.size()) + ",\"changed\":" + std::to_string(changes.changed.size())
+		+ ",\"pages\":" + std::to_string(site.pages.size() * backends.size()) + ",\"rendered\":" + std::to_string(tasks.size())
+		+ ",\"lint\":" + std::to_string(findings.size()) + ",\"written\":";
+	AppendFiles(reply, changed_files);
+	reply += ",\"stale\":";
+	AppendFiles(reply, stale_files);
+	reply += ",\"milliseconds\":{\"read\":" + std::to_string(Milliseconds(start, read)) + ",\"lint\":" + std::to_string(Milliseconds(read, linted))
+		+ ",\"render\":" + std::to_string(Milliseconds(linted, rendered)) + ",\"write\":" + std::to_string(Milliseconds(rendered, wrote))
+		+ ",\"total\":" + std::to_string(Milliseconds(start, wrote)) + "}}";
+
+	if (failed)
+		reply.insert(1, "\"error\":\"Some pages could not be written.\",");
+
+	MLOG(Info, "Build " << requests << ": " << changes.added.size() << " added, " << changes.removed.size() << " removed, " << changes.changed.size()
+		<< " changed; rendered " << tasks.size() << " and wrote " << changed_files.size() << " pages in " << Milliseconds(start, wrote) << " ms.");
+
+	Pipeline::Report();
+	SwapChars::Report();
+
+	RunReport::Set("daemon", reply);
+	if (options.report.length() != 0 && !RunReport::Write(options.report))
+		MLOG(Error, "Failed to write the run report to " << options.report);
+
+	return reply;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MW.h"
+#include "MMacros.h"
+#include "Options.h"
+#include "ParameterStore.h"
+
+class Writer;
+
+/*
+* Stays resident between builds of MW and regenerates the documentation when a client,
+  MGenerator build, asks it to over a UNIX domain socket.
+*
+* The last parse of MW.xml and every page it last wrote are kept in memory. A request
+  is diffed against the last parse with ApiDiff: if members were only changed, only the
+  pages of their namespaces are rendered again, and of those, only the pages whose
+  content differs are written.
+*
+* A request is one line, "generate <absolute path to MW.xml>" or "stop". The reply is a
+  JSON object with the files written and how long each step took, or with an "error" if
+  the MW.xml could not be read, in which case the last parse is kept.
+*/
+class BuildServer
+{
+
+public:
+
+	/* backends must outlive this BuildServer. options are those of every request. */
+	BuildServer(const VT(Writer*)& backends, const Options& options);
+
+	/* Serves requests on the socket at socket_path until a stop request. Returns non-zero if it could not listen. */
+	int Run(const std::string& socket_path);
+
+	/* Sends request to the daemon at socket_path and receives its reply. False if no daemon is listening. */
+	static bool Send(const std::string& socket_path, const std::string& request, std::string& reply);
+
+private:
+
+	/* Regenerates from the MW.xml at input and returns the reply. */
+	std::string Generate(const std::string& input);
+
+	VT(Writer*) backends;
+	Options options;
+
+	// The last parse. Every MW points into parameters, so it is never moved.
+	std::unique_ptr<ParameterStore> parameters;
+	VT(MW) all_mw;
+
+	// The last content written of every page of every backend, by page name.
+	std::vector<std::map<std::string, std::string>> written;
+
+	// The last content written of every index of every backend, by file. See Writer::WriteIndex.
+	std::vector<std::map<std::string, std::string>> indexes;
+
+	size_t requests;
+
+};
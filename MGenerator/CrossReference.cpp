@@ -0,0 +1,117 @@
+#include <algorithm>
+
+#include "CrossReference.h"
+#include "Inline.h"
+#include "Log.h"
+
+void CrossReference::Build(const VT(MW)& all_mw)
+{
+	index.clear();
+	index.reserve(all_mw.size());
+
+	for (auto& mw : all_mw)
+	{
+		index.emplace(mw.doc_id, &mw);
+	}
+
+	resolved = 0;
+	unresolved = 0;
+	unresolved_crefs.clear();
+
+	for (auto& mw : all_mw)
+	{
+		Count(mw.summary, mw);
+		Count(mw.remarks, mw);
+		Count(mw.returns, mw);
+
+		for (uint32_t i = 0; i < mw.name_count; ++i)
+			Count(mw.ParameterDescription(i), mw);
+
+		for (auto& cref : mw.see_also)
+		{
+			if (Resolve(cref))
+			{
+				++resolved;
+			}
+			else
+			{
+				++unresolved;
+				unresolved_crefs.emplace(cref, mw.doc_id);
+			}
+		}
+	}
+}
+
+const MW* CrossReference::Resolve(const std::string& cref) const
+{
+	auto found = index.find(cref);
+
+	return found != index.end() ? found->second : nullptr;
+}
+
+std::string CrossReference::Link(const MW& target, const char* extension) const
+{
+	return target.mw_namespace + extension + '#' + target.Anchor();
+}
+
+std::string CrossReference::Label(const std::string& cref, const MW* target)
+{
+	if (target)
+	{
+		if (target->mw_name.length() == 0)
+			return target->mw_class.length() != 0 ? target->mw_class : target->mw_namespace;
+
+		if (target->mw_name == "CONSTRUCTOR")
+			return target->mw_class;
+
+		return target->mw_class + '.' + target->mw_name;
+	}
+
+	// Unresolved. Show the last part of the documentation ID before any parameters.
+	// E.g., M:UnityEngine.Vector3.Dot(...) shows Dot.
+	size_t end = cref.find('(');
+	if (end == std::string::npos)
+		end = cref.length();
+
+	size_t begin = cref.rfind('.', end);
+	begin = begin == std::string::npos ? cref.find(':') : begin;
+
+	std::string label = cref.substr(begin + 1, end - begin - 1);
+
+	// Generic arity. E.g., MDeque`1.
+	label.erase(std::find(label.begin(), label.end(), '`'), label.end());
+
+	return label;
+}
+
+void CrossReference::Report() const
+{
+	MLOG(Info, "Cross-references: " << resolved << " resolved, " << unresolved << " unresolved.");
+
+	for (auto& cref : unresolved_crefs)
+	{
+		MLOG(Warning, "\tUnresolved cref " << cref.first << " in " << cref.second);
+	}
+}
+
+void CrossReference::Count(std::string_view text, const MW& from)
+{
+	if (!Inline::HasElements(text))
+		return;
+
+	Inline::ForEach(text, [](const char*, size_t) {}, [&](const InlineElement& element)
+		{
+			if (!element.IsCref())
+				return;
+
+			if (Resolve(element.target))
+			{
+				++resolved;
+			}
+			else
+			{
+				++unresolved;
+				unresolved_crefs.emplace(element.target, from.doc_id);
+			}
+		});
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <map>
+
+#include "MW.h"
+#include "MMacros.h"
+
+/*
+* Resolves a cref, the raw documentation ID in <see cref="...">, to the MW it documents.
+* The index is built once over every MW, keyed by MW::doc_id, so that each cref is
+  resolved with a single hash lookup.
+*/
+class CrossReference
+{
+
+public:
+
+	/*
+	* Indexes all_mw and resolves every cref that appears in all_mw, counting those
+	  that do not resolve.
+	* all_mw must outlive this CrossReference and must not be resized.
+	*/
+	void Build(const VT(MW)& all_mw);
+
+	/* The MW documented by cref, or nullptr if cref is not in the index. */
+	const MW* Resolve(const std::string& cref) const;
+
+	/* The page, relative to its Writer's output, and anchor of cref. E.g., MArray.html#M-MW.MArray-1.Push--0-. */
+	std::string Link(const MW& target, const char* extension) const;
+
+	/* The text to show for a cref with no label. */
+	static std::string Label(const std::string& cref, const MW* target);
+
+	size_t Resolved() const { return resolved; }
+	size_t Unresolved() const { return unresolved; }
+
+	/* Writes the number of resolved and unresolved crefs, and every unresolved cref. */
+	void Report() const;
+
+private:
+
+	void Count(std::string_view text, const MW& from);
+
+	std::unordered_map<std::string_view, const MW*> index;
+
+	size_t resolved = 0;
+	size_t unresolved = 0;
+
+	// Unresolved cref -> The doc_id of the first MW that references it.
+	std::map<std::string, std::string> unresolved_crefs;
+
+};
@@ -1,12 +1,29 @@
 
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
 #include "MMacros.h"
 #if WITH_TIMER
-#include <iostream>
 #include "Timer.h"
 #endif
 
+#include "Log.h"
+#include "Options.h"
+#include "ApiDiff.h"
+#include "BuildServer.h"
+#include "Lint.h"
 #include "Reader.h"
-#include "Writer.h"
+#include "HTMLWriter.h"
+#include "MarkdownWriter.h"
+#include "ModelWriter.h"
+#include "PreviewServer.h"
+#include "MemoryStats.h"
+#include "OutputSink.h"
+#include "PhaseProfiler.h"
+#include "RunReport.h"
+#include "SwapChars.h"
+#include "Versions.h"
 
 /* 
 * Do not run in Visual Studio with the 'Release' Configuration.
@@ -14,20 +31,215 @@
 * Building MW should automatically call Generator.
 */
 
-int main()
+/* The Writer of every format in --formats, owned by owned. */
+static VT(Writer*) CreateBackends(const Options& options, VT(std::unique_ptr<Writer>)& owned)
+{
+	VT(Writer*) backends;
+
+	for (const std::string& format : options.formats)
+	{
+		if (format == "html")
+			owned.emplace_back(new HTMLWriter(options.minify, options.report.length() != 0));
+		else if (format == "markdown")
+			owned.emplace_back(new MarkdownWriter());
+		else if (format == "json")
+			owned.emplace_back(new ModelWriter(EModelFormat::JSON));
+		else if (format == "binary")
+			owned.emplace_back(new ModelWriter(EModelFormat::Binary));
+		else
+			continue;
+
+		backends.push_back(owned.back().get());
+	}
+
+	return backends;
+}
+
+int main(int argc, char** argv)
 {
+	const Options options = Options::Parse(argc, argv);
+	Log::SetLevel(options.log_level);
+
+	if (options.counters)
+		PhaseProfiler::Enable();
+
 #if WITH_TIMER
 	PerformanceTimer t;
 	t.StartTime();
 #endif
 
-	std::vector<MW> all_mw = Reader::OpenFile();
-	Writer::Write(all_mw);
+	if (options.command == ECommand::Benchmark)
+	{
+		const bool same = Reader::BenchmarkParsers(options.input.length() != 0 ? options.input : Reader::DefaultPath(), options.Stages(), options.runs);
+
+		if (options.report.length() != 0 && !RunReport::Write(options.report))
+			MLOG(Error, "Failed to write the run report to " << options.report);
+
+		Log::Stop();
+		return same ? 0 : -1;
+	}
+
+	if (options.command == ECommand::Daemon)
+	{
+		VT(std::unique_ptr<Writer>) owned;
+		BuildServer server(CreateBackends(options, owned), options);
+		const int result = server.Run(options.socket);
+
+		Log::Stop();
+		return result;
+	}
+
+	if (options.command == ECommand::Build || options.command == ECommand::Stop)
+	{
+		std::string reply;
+		bool sent = false;
+
+		if (options.command == ECommand::Stop)
+		{
+			sent = BuildServer::Send(options.socket, "stop", reply);
+		}
+		else if (options.input == "-" || options.input.compare(0, 3, "fd:") == 0)
+		{
+			// A stream can only be read by this process.
+			MLOG(Info, "MW.xml is read from " << options.input << "; generating in this process.");
+		}
+		else
+		{
+			// The daemon resolves paths against its own working directory.
+			std::error_code ignored;
+			const std::string input = std::filesystem::absolute(options.input.length() != 0 ? options.input : Reader::DefaultPath(), ignored).lexically_normal().string();
+			sent = BuildServer::Send(options.socket, "generate " + input, reply);
+
+			if (!sent)
+				MLOG(Warning, "There is no daemon at " << options.socket << "; generating in this process.");
+		}
+
+		// Every reply ends with a newline. Without one, the daemon went away while building,
+		// so nothing says what it wrote.
+		if (sent && (reply.empty() || reply.back() != '\n'))
+		{
+			if (options.command == ECommand::Stop)
+			{
+				MLOG(Error, "The daemon at " << options.socket << " did not finish its reply to stop.");
+				Log::Stop();
+				return -1;
+			}
+
+			MLOG(Warning, "The daemon at " << options.socket << " did not finish its reply; generating in this process.");
+			sent = false;
+		}
+
+		if (sent)
+		{
+			std::cout << reply;
+			Log::Stop();
+			return reply.find("\"error\"") == std::string::npos ? 0 : -1;
+		}
+
+		if (options.command == ECommand::Stop)
+		{
+			MLOG(Error, "There is no daemon at " << options.socket << " to stop.");
+			Log::Stop();
+			return -1;
+		}
+	}
+
+	if (options.command == ECommand::Merge)
+	{
+		// Nothing is read; only the manifest fragments of the shards are merged.
+		VT(std::unique_ptr<Writer>) owned;
+
+		bool merged = true;
+		for (Writer* backend : CreateBackends(options, owned))
+		{
+			merged &= Shard::Merge(backend->OutputPath(), backend->Name());
+		}
+
+		Log::Stop();
+		return merged ? 0 : -1;
+	}
+
+	if (options.command == ECommand::Versions)
+	{
+		// Every version is read from its own MW.xml, instead of --input.
+		VT(std::unique_ptr<Writer>) owned;
+		const bool written = Versions::Generate(options.versions, CreateBackends(options, owned), options);
+		PhaseProfiler::Report();
+		Pipeline::Report();
+		SwapChars::Report();
+
+		if (options.report.length() != 0 && !RunReport::Write(options.report))
+			MLOG(Error, "Failed to write the run report to " << options.report);
+
+		Log::Stop();
+		return written ? 0 : -1;
+	}
+
+	// Owns the parameters of every MW in all_mw.
+	ParameterStore parameters;
+	std::vector<MW> all_mw = Reader::OpenFile(options.input, options.Stages(), parameters, options.parser);
+
+	if (options.command == ECommand::Serve)
+	{
+		// Pages are only rendered when they are requested, so nothing else is done up front.
+		HTMLWriter html(options.minify);
+		PreviewServer server(all_mw, html, options.cache_mb * 1024 * 1024);
+		const int result = server.Run(options.port);
+
+		Log::Stop();
+		return result;
+	}
+
+	if (options.command == ECommand::Diff)
+	{
+		// Only the changelog is written; the pages of either version are left as they are.
+		ParameterStore base_parameters;
+		const std::vector<MW> base_mw = Reader::OpenFile(options.base, options.Stages(), base_parameters, options.parser);
+
+		VT(std::unique_ptr<Writer>) owned;
+		const std::unique_ptr<OutputSink> sink = OutputSink::Create(options.sink);
+		const bool written = ApiDiff::WriteChangelog(base_mw, all_mw, CreateBackends(options, owned), *sink);
+		Pipeline::Report();
+
+		if (options.report.length() != 0 && !RunReport::Write(options.report))
+			MLOG(Error, "Failed to write the run report to " << options.report);
+
+		Log::Stop();
+		return written ? 0 : -1;
+	}
+
+	// Check the documentation of every MW and report the findings once.
+	PhaseScope process(EPhase::Process);
+	const VT(LintFinding) findings = Lint::Run(all_mw, options.Threads());
+	if (options.lint_json.length() != 0)
+	{
+		if (!Lint::WriteJSON(findings, options.lint_json))
+			MLOG(Error, "Failed to write lint findings to " << options.lint_json);
+	}
+	else
+	{
+		Lint::Print(findings);
+	}
+
+	// Every backend renders from the same parse of MW.xml.
+	VT(std::unique_ptr<Writer>) owned;
+	const std::unique_ptr<OutputSink> sink = OutputSink::Create(options.sink);
+	Writer::WriteAll(all_mw, CreateBackends(options, owned), options.Stages(), *sink, options.subtree, options.shard);
+
+	MemoryStats::Report(all_mw.size());
+	PhaseProfiler::Report();
+	Pipeline::Report();
+	SwapChars::Report();
+
+	if (options.report.length() != 0 && !RunReport::Write(options.report))
+		MLOG(Error, "Failed to write the run report to " << options.report);
 
 #if WITH_TIMER
 	t.PrintTime("\nFiles Generated in:");
 	std::cin.get();
 #endif
 
+	Log::Stop();
+
 	return 0;
 }
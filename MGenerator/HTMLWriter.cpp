@@ -0,0 +1,621 @@
+#include <cctype>
+#include <sstream>
+
+#include "MMacros.h"
+#include "HTMLWriter.h"
+#include "ApiDiff.h"
+#include "MW.h"
+#include "CrossReference.h"
+#include "Inline.h"
+#include "Text.h"
+#include "Log.h"
+#include "RunReport.h"
+
+#if BUILD
+#include "Timer.h"
+#endif
+
+#define Q(s) "\""#s"\""
+
+#define HTML_HEADER(title) "<!DOCTYPE html><html lang=" \
+			Q(en) \
+			"><head>" \
+			"<title>" << title << " | MW Unity Namespace</title><link rel=" Q(stylesheet) " href=" \
+			Q(CSS/MWUnityNamespace.css) \
+			"><meta charset=" \
+			"UTF-8" \
+			"></head><body><div class=" Q(header) " id=" Q(top) ">" \
+			"MW UNITY NAMESPACE</div>" \
+
+#define HTML_END "</div></div></div></body></html>"
+
+/*
+* CSS styles to apply to html.
+*/
+
+/*
+* The div marking the beginning of the two column table.
+* The left column is the nav links with the complete MW
+  namespace and links to their XML tags.
+* The right column describes the fields/properties/functions
+  constructors and summaries of the respective namespace
+  function.
+*/
+#define CSS_HOLDING_DIV Q(width: 100%; display: table;)
+/*
+* The div marking the first and only row in the file.
+*/
+#define CSS_INNER_DIV Q(display: table-row)
+/*
+* The div defining the styles of the left column.
+*/
+#define CSS_LEFT_COL_DIV Q(width: 200px; display: table-cell;)
+/*
+* The div defining the styles of the right column.
+*/
+#define CSS_RIGHT_COL_DIV Q(display: table-cell;)
+/*
+* The CSS selector used for every link in the navbar.
+*/
+constexpr const char* CSS_NAV_LINKS = Q(navLinks);
+/*
+* The CSS selector used for the expanded namespaces in the navbar.
+*/
+constexpr const char* CSS_NAV_TREE = Q(navTree);
+/*
+* The CSS selector used to define the style for namespace classes or
+  functions, depending on whether the namespace class is a part of
+  the root MW namespace.
+*/
+constexpr const char* CSS_HEADER_STYLE = Q(FuncTitle);
+/*
+* The CSS selector/s used to define the style for namespace classes.
+*/
+constexpr const char* CSS_CLASS_STYLE = Q(DefinedType C);
+/*
+* The CSS selector/s used to style the namespace class summary.
+*/
+constexpr const char* CSS_CLASS_SUMMARY_STYLE = Q(simplePara C);
+/*
+* The CSS selector used to style function summaries and parameter
+  definitions.
+*/
+constexpr const char* CSS_PARAGRAPH = Q(simplePara);
+/*
+* The CSS selector used to style names of function parameters.
+*/
+constexpr const char* CSS_PARAM_NAME = Q(ParamName);
+/*
+* The CSS selector used to style function parameters' descriptions.
+*/
+#define CSS_PARAM_DESC Q(ParamDesc)
+/*
+* The CSS selector used to style keywords for function summaries.
+*/
+constexpr const char* CSS_KEYWORD = Q(keyword);
+
+/*
+* The inline styles of class and function decorations.
+*/
+#define CSS_CLASS_DECORATIONS Q(padding-right:25%;color:rgb(126, 252, 202);)
+#define CSS_FUNCTION_DECORATIONS Q(padding-right:25%;color:rgb(126, 252, 202);font-weight:549)
+
+/*
+* HTML shorthand for writing tab spaces.
+*/
+#define HTML_TAB "&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;"
+
+/*
+* The attributes that style the layout of a page.
+* Minified pages use the classes in CSS/MWUnityNamespace.css instead of inline styles.
+*/
+struct HTMLStyle
+{
+	const char* holding_div;
+	const char* inner_div;
+	const char* left_col_div;
+	const char* right_col_div;
+	const char* class_decorations;
+	const char* function_decorations;
+	const char* param_desc;
+	const char* tab;
+	const char* nav_break;
+};
+
+static const HTMLStyle INLINE_STYLE =
+{
+	"style=" CSS_HOLDING_DIV,
+	"style=" CSS_INNER_DIV,
+	"style=" CSS_LEFT_COL_DIV,
+	"style=" CSS_RIGHT_COL_DIV,
+	"class=" Q(C) " style=" CSS_CLASS_DECORATIONS,
+	"style=" CSS_FUNCTION_DECORATIONS,
+	"class=" CSS_PARAM_DESC,
+	HTML_TAB,
+	"<br>"
+};
+
+static const HTMLStyle MINIFIED_STYLE =
+{
+	"class=" Q(Table),
+	"class=" Q(Row),
+	"class=" Q(NavCol),
+	"class=" Q(DocCol),
+	"class=" Q(C ClassDecor),
+	"class=" Q(FuncDecor),
+	"class=" Q(ParamDesc Tab),
+	"",
+	""
+};
+
+#if WRITE_DEBUG_LINES
+#define DEBUG_WRITELINE << "<p style=" Q(color:white) ">" INTER_INJECT_TEXT(__LINE__) << "</p>"
+#define GET_LINE << " L" << __LINE__
+#else
+#define DEBUG_WRITELINE
+#define GET_LINE
+#endif
+
+#define INTER_INJECT_TEXT(text) << text GET_LINE
+#define INTER_INJECT_CLASS_DECORATIONS(decorations) "<pre " << style.class_decorations << ">" INTER_INJECT_TEXT(decorations) << "</pre>"
+#define INTER_INJECT_FUNCTION_DECORATIONS(decorations) "<br><pre " << style.function_decorations << ">" INTER_INJECT_TEXT(decorations) << "</pre>"
+
+#define FMT_PARAM_PRIM_TYPE(type) "<span class=" Q(PrimitiveType) ">" + type + "</span>"
+#define FMT_PARAM_DEF_TYPE(type) "<span class=" Q(DefinedType) ">" + type + "</span>"
+#define FMT_PARAM_NAME(name) "<span class=" Q(FuncParamName) ">" + name + "</span>"
+#define FMT_PRIM_FUNC(type, name) FMT_PARAM_PRIM_TYPE(type) " " FMT_PARAM_NAME(name)
+#define FMT_DEF_FUNC(type, name) FMT_PARAM_DEF_TYPE(type) " " FMT_PARAM_NAME(name)
+
+#define HTML_HOLDING_DIV "<div " << style.holding_div << "><div " << style.inner_div << "><div " << style.left_col_div << ">" DEBUG_WRITELINE
+#define HTML_NAV_ENTRY(path, entry) "<div class=" << CSS_NAV_LINKS << "><a href=\"" << path << ".html\">" << entry << "</a></div>" << style.nav_break DEBUG_WRITELINE
+#define HTML_NAV_LABEL(entry) "<div class=" << CSS_NAV_LINKS << ">" << entry << "</div>" << style.nav_break DEBUG_WRITELINE
+#define HTML_NAV_TREE_START(summary) "<details open class=" << CSS_NAV_TREE << "><summary>" << summary << "</summary>" DEBUG_WRITELINE
+#define HTML_NAV_TREE_END "</details>"
+#define HTML_SUMMARY_START "</div><br><br><div " << style.right_col_div << ">" DEBUG_WRITELINE
+#define HTML_ANCHOR(anchor) " id=\"" << anchor << "\""
+#define HTML_CLASS_START(anchor, entry, summary, decorations) INTER_INJECT_CLASS_DECORATIONS(decorations) << "</pre><h1 class=" << CSS_CLASS_STYLE << HTML_ANCHOR(anchor) << ">" INTER_INJECT_TEXT(entry) << "</h1><br><p class=" << CSS_CLASS_SUMMARY_STYLE << ">" INTER_INJECT_TEXT(summary) << "</p>" DEBUG_WRITELINE
+#define HTML_SUMMARY_TITLE(anchor, title, decorations) INTER_INJECT_FUNCTION_DECORATIONS(decorations) << "<p class=" << CSS_HEADER_STYLE << HTML_ANCHOR(anchor) << ">" INTER_INJECT_TEXT(title) << "</p>" DEBUG_WRITELINE
+#define HTML_DECLARE_FUNCTION_PARAMS(anchor, title, params, decorations) INTER_INJECT_FUNCTION_DECORATIONS(decorations) << "<h1 class=" << CSS_HEADER_STYLE << HTML_ANCHOR(anchor) << ">" INTER_INJECT_TEXT(title) << " (" INTER_INJECT_TEXT(params) << ")</h1>" DEBUG_WRITELINE
+#define HTML_DECLARE_OPERATOR_OVERLOAD(overload, params, decorations) INTER_INJECT_FUNCTION_DECORATIONS(decorations) << "<br><h1 class" << CSS_HEADER_STYLE << ">" INTER_INJECT_TEXT(overload) INTER_INJECT_TEXT(params) << "</h1>" DEBUG_WRITELINE
+#define HTML_SUMMARY_ENTRY(entry) "<p class=" << CSS_PARAGRAPH << ">" INTER_INJECT_TEXT(entry) << "</p>" DEBUG_WRITELINE
+#define HTML_PARAM_ENTRY(var, desc) "<p class=" << CSS_PARAM_NAME << ">" INTER_INJECT_TEXT(var) << "</p><p " << style.param_desc << ">" << style.tab INTER_INJECT_TEXT(desc) << "</p>" DEBUG_WRITELINE
+#define HTML_SEE_ALSO(links) HTML_KEYWORD("See Also:") << HTML_SUMMARY_ENTRY(links)
+#define HTML_CHANGELOG_SECTION(title, count) "<h1 class=" << CSS_CLASS_STYLE << ">" INTER_INJECT_TEXT(title) << " (" << count << ")</h1>" DEBUG_WRITELINE
+#define HTML_CHANGELOG_ENTRY(link, kind, title) "<p class=" << CSS_HEADER_STYLE << ">" << kind << " <a class=" Q(DefinedType) " href=\"" << link << "\">" INTER_INJECT_TEXT(title) << "</a></p>" DEBUG_WRITELINE
+#define HTML_CHANGELOG_LABEL(kind, title) "<p class=" << CSS_HEADER_STYLE << ">" << kind << " " INTER_INJECT_TEXT(title) << "</p>" DEBUG_WRITELINE
+#define HTML_KEYWORD(keyword) "<p class=" << CSS_KEYWORD << ">" INTER_INJECT_TEXT(keyword) << "</p>" DEBUG_WRITELINE
+
+std::string HTMLWriter::OutputPath() const
+{
+#if EXEC_FROM_VS
+	return "../Docs/HTML/";
+#else
+	return "../../Docs/HTML/";
+#endif
+}
+
+namespace
+{
+	/* Counts the characters written to it, and discards them. */
+	class CountingBuffer : public std::streambuf
+	{
+
+	public:
+
+		size_t count = 0;
+
+	protected:
+
+		int_type overflow(int_type c) override
+		{
+			if (!traits_type::eq_int_type(c, traits_type::eof()))
+				++count;
+
+			return traits_type::not_eof(c);
+		}
+
+		std::streamsize xsputn(const char*, std::streamsize n) override
+		{
+			count += static_cast<size_t>(n);
+			return n;
+		}
+
+	};
+}
+
+void HTMLWriter::RenderPage(std::ostream& html, const Page& page, const Site& site, const CrossReference& crefs) const
+{
+	if (!minify)
+	{
+		Render(html, page, site, crefs, INLINE_STYLE);
+		return;
+	}
+
+	std::ostringstream rendered;
+	Render(rendered, page, site, crefs, MINIFIED_STYLE);
+
+	const std::string minified = Minify(rendered.str());
+	html.write(minified.data(), minified.size());
+
+	minified_bytes += minified.size();
+
+	if (!measure && !Log::Enabled(ELogLevel::Verbose))
+		return;
+
+	// The size this page would have been, only for the report.
+	CountingBuffer full;
+	std::ostream counter(&full);
+	Render(counter, page, site, crefs, INLINE_STYLE);
+
+	full_bytes += full.count;
+
+	MLOG(Verbose, page.name << Extension() << ": " << full.count << " -> " << minified.size() << " bytes, saved " << static_cast<long long>(full.count) - static_cast<long long>(minified.size()) << '.');
+}
+
+void HTMLWriter::Summarise() const
+{
+	if (!minify)
+		return;
+
+	const size_t full = full_bytes, minified = minified_bytes;
+
+	if (full == 0)
+	{
+		// Pages were not rendered unminified, so there is nothing to compare against.
+		MLOG(Info, "Minified HTML: " << minified << " bytes.");
+		RunReport::Set("minify", "{\"minified_bytes\":" + std::to_string(minified) + "}");
+		return;
+	}
+
+	// Signed, in case minifying ever makes a page larger.
+	const long long saved = static_cast<long long>(full) - static_cast<long long>(minified);
+
+	MLOG(Info, "Minified HTML: " << full << " -> " << minified << " bytes, saved " << saved << " (" << saved * 100 / static_cast<long long>(full) << "%).");
+
+	RunReport::Set("minify", "{\"full_bytes\":" + std::to_string(full) + ",\"minified_bytes\":" + std::to_string(minified) + ",\"saved_bytes\":" + std::to_string(saved) + "}");
+}
+
+void HTMLWriter::RenderChangelog(std::ostream& html, const ApiChanges& changes, const CrossReference& crefs) const
+{
+	if (!minify)
+	{
+		RenderChanges(html, changes, crefs, INLINE_STYLE);
+		return;
+	}
+
+	std::ostringstream rendered;
+	RenderChanges(rendered, changes, crefs, MINIFIED_STYLE);
+
+	const std::string minified = Minify(rendered.str());
+	html.write(minified.data(), minified.size());
+}
+
+void HTMLWriter::RenderChanges(std::ostream& html, const ApiChanges& changes, const CrossReference& crefs, const HTMLStyle& style) const
+{
+	// The same layout as a page, with an empty nav column.
+	html << HTML_HEADER("Changelog") << HTML_HOLDING_DIV << HTML_SUMMARY_START;
+
+	html << HTML_CHANGELOG_SECTION("Added", changes.added.size());
+	for (const MW* mw : changes.added)
+	{
+		html << HTML_CHANGELOG_ENTRY(crefs.Link(*mw, Extension()), ApiDiff::Kind(*mw), Text::HTML(ApiDiff::Title(*mw)));
+
+		if (mw->summary.length() != 0)
+			html << HTML_SUMMARY_ENTRY(FormatText(mw->summary, crefs));
+	}
+
+	html << HTML_CHANGELOG_SECTION("Removed", changes.removed.size());
+	for (const MW* mw : changes.removed)
+	{
+		html << HTML_CHANGELOG_LABEL(ApiDiff::Kind(*mw), Text::HTML(ApiDiff::Title(*mw)));
+	}
+
+	html << HTML_CHANGELOG_SECTION("Changed", changes.changed.size());
+	for (const ApiChange& change : changes.changed)
+	{
+		const MW& mw = *change.after;
+
+		html << HTML_CHANGELOG_ENTRY(crefs.Link(mw, Extension()), ApiDiff::Kind(mw), Text::HTML(ApiDiff::Title(mw)));
+
+		if (change.signature)
+			html << HTML_KEYWORD("Signature changed.");
+
+		if (change.documentation)
+			html << HTML_KEYWORD("Documentation changed.");
+
+		if (change.before->summary != mw.summary)
+		{
+			html << HTML_KEYWORD("Summary:") << HTML_SUMMARY_ENTRY(FormatText(mw.summary, crefs));
+			html << HTML_KEYWORD("Was:") << HTML_SUMMARY_ENTRY(FormatText(change.before->summary, crefs));
+		}
+	}
+
+	html << HTML_END;
+}
+
+void HTMLWriter::Render(std::ostream& html, const Page& page, const Site& site, const CrossReference& crefs, const HTMLStyle& style) const
+{
+	// Write/Create basic HTML file.
+	html << HTML_HEADER(page.name) << HTML_HOLDING_DIV;
+
+	// Write the namespace links of this page's ancestors and siblings.
+	// page is always one of site.pages.
+	const size_t current = site.namespaces.NodeOf(static_cast<size_t>(&page - site.pages.data()));
+	RenderNav(html, site.namespaces, NamespaceTrie::Root(), current, style);
+
+	// Prepare the right column.
+	html << HTML_SUMMARY_START;
+
+	for (const MW& mw : page)
+	{
+		RenderMember(html, mw, crefs, style);
+	}
+
+	// End basic HTML file.
+	html << HTML_END;
+}
+
+void HTMLWriter::RenderNav(std::ostream& html, const NamespaceTrie& namespaces, const size_t node, const size_t current, const HTMLStyle& style) const
+{
+	for (size_t child : namespaces[node].children)
+	{
+		const NamespaceTrie::Node& nav = namespaces[child];
+
+		std::ostringstream entry;
+		if (nav.page != NamespaceTrie::NONE)
+			entry << HTML_NAV_ENTRY(nav.path, nav.name);
+		else
+			entry << HTML_NAV_LABEL(nav.name);
+
+		// Only the path to the current page is expanded.
+		if (!nav.children.empty() && namespaces.Contains(child, current))
+		{
+			html << HTML_NAV_TREE_START(entry.str());
+			RenderNav(html, namespaces, child, current, style);
+			html << HTML_NAV_TREE_END;
+		}
+		else
+		{
+			html << entry.str();
+		}
+	}
+}
+
+void HTMLWriter::RenderMember(std::ostream& html, const MW& mw, const CrossReference& crefs, const HTMLStyle& style) const
+{
+	if (mw.mw_name.length() == 0)
+	{
+		html << HTML_CLASS_START(mw.Anchor(),
+			(mw.mw_class.length() != 0
+				? mw.mw_class
+				: mw.mw_namespace)
+			, FormatText(mw.summary, crefs), GetDecorations(mw.decorations));
+	}
+	else
+	{
+		if (mw.type_count == 0)
+		{
+			if (mw.mw_type == MEMBER)
+			{
+				if (mw.implicit.length() == 0)
+				{
+					// A function.
+					// Because this type_count == 0, this has no parameters.
+					// Write the name of the function with empty brackets.
+					html << HTML_DECLARE_FUNCTION_PARAMS(mw.Anchor(), mw.mw_name, "", GetDecorations(mw.decorations));
+				}
+				else
+				{
+					// An implicit operator.
+					html << HTML_DECLARE_FUNCTION_PARAMS(mw.Anchor(), mw.implicit, "", GetDecorations(mw.decorations));
+				}
+
+				// If there is a summary, write it here.
+				if (mw.summary.length() != 0)
+					html << HTML_KEYWORD("Summary:") << HTML_SUMMARY_ENTRY(FormatText(mw.summary, crefs));
+
+				// If there are remarks, write it here.
+				if (mw.remarks.length() != 0)
+					html << HTML_KEYWORD("Remarks:") << HTML_SUMMARY_ENTRY(FormatText(mw.remarks, crefs));
+
+				// If there is a return value, write it here.
+				if (mw.returns.length() != 0)
+					html << HTML_KEYWORD("Returns:") << HTML_SUMMARY_ENTRY(FormatText(mw.returns, crefs));
+			}
+			else
+			{
+				bool no_class = mw.mw_class.length() == 0;
+				// Not a function.
+				// Write whatever this is normally.
+				if (no_class ^ mw.mw_type == FIELD ^ mw.mw_type == PROPERTY)
+				{
+					html << HTML_SUMMARY_TITLE(mw.Anchor(), mw.mw_name, GetDecorations(mw.decorations)) << HTML_SUMMARY_ENTRY(FormatText(mw.summary, crefs));
+
+					if (mw.remarks.length() != 0)
+						html << HTML_SUMMARY_ENTRY(FormatText(mw.remarks, crefs));
+				}
+				else
+				{
+					html << HTML_CLASS_START(mw.Anchor(), mw.mw_name, FormatText(mw.summary, crefs) + "<br>" + FormatText(mw.remarks, crefs), GetDecorations(mw.decorations));
+				}
+			}
+		}
+		else
+		{
+			std::string param;
+			const VT(std::string) param_types = GetParameterTypes(mw);
+			auto size_of_name = param_types.size();
+
+			// Writing function parameter types.
+			for (int i = 0; i < size_of_name; ++i)
+			{
+				const std::string& param_type = param_types[i];
+				std::string param_name;
+
+				param_name += mw.ParameterName(i);
+
+				if (i != size_of_name - 1)
+					param_name += ", ";
+
+				param += (param_type.length() && std::isupper(param_type[0]))
+					? FMT_DEF_FUNC(param_type, param_name)
+					: FMT_PRIM_FUNC(param_type, param_name);
+			}
+
+			// Write the name of the function.
+			html << HTML_DECLARE_FUNCTION_PARAMS(mw.Anchor(), mw.mw_name, param, GetDecorations(mw.decorations));
+
+			// If there is a summary, write it here.
+			if (mw.summary.length() != 0)
+				html << HTML_KEYWORD("Summary:") << HTML_SUMMARY_ENTRY(FormatText(mw.summary, crefs));
+
+			// If there are remarks, write it here.
+			if (mw.remarks.length() != 0)
+				html << HTML_KEYWORD("Remarks:") << HTML_SUMMARY_ENTRY(FormatText(mw.remarks, crefs));
+
+			// Write the summaries for the parameters (if any).
+			for (int i = 0; i < size_of_name; ++i)
+			{
+				bool has_description = mw.ParameterDescription(i).length() != 0;
+
+				if (i == 0 && has_description)
+					html << HTML_KEYWORD("Params:");
+
+				if (has_description)
+				{
+					html << HTML_PARAM_ENTRY(mw.ParameterName(i) << ": ", FormatText(mw.ParameterDescription(i), crefs));
+				}
+			}
+
+			// If there is a return value, write it here.
+			if (mw.returns.length() != 0)
+				html << HTML_KEYWORD("Returns:") << HTML_SUMMARY_ENTRY(FormatText(mw.returns, crefs));
+		}
+	}
+
+	if (mw.see_also.size() != 0)
+		html << HTML_SEE_ALSO(GetSeeAlso(mw.see_also, crefs, ", "));
+}
+
+std::string HTMLWriter::FormatInline(const InlineElement& element, const CrossReference& crefs) const
+{
+	switch (element.kind)
+	{
+	case EInline::See:
+	case EInline::SeeAlso:
+	{
+		const MW* target = crefs.Resolve(element.target);
+		const std::string label = Text::HTML(element.label.length() != 0 ? element.label : CrossReference::Label(element.target, target));
+
+		if (!target)
+			return FMT_PARAM_DEF_TYPE(label);
+
+		return "<a class=" Q(DefinedType) " href=\"" + crefs.Link(*target, Extension()) + "\">" + label + "</a>";
+	}
+	case EInline::ParamRef:
+		return FMT_PARAM_NAME(Text::HTML(element.target));
+	case EInline::TypeParamRef:
+		return FMT_PARAM_DEF_TYPE(Text::HTML(element.target));
+	case EInline::LangWord:
+		return FMT_PARAM_PRIM_TYPE(Text::HTML(element.target));
+	case EInline::Code:
+		return "<code>" + Text::HTML(element.target) + "</code>";
+	}
+
+	return Text::HTML(element.target);
+}
+
+void HTMLWriter::AppendText(std::string& out, const char* raw, const size_t length) const
+{
+	Text::AppendHTML(out, raw, length);
+}
+
+std::string HTMLWriter::GetDecorations(const VT(std::string)& decorations)
+{
+	if (decorations.empty())
+		return std::string();
+
+	std::string decor = "<br>";
+
+	for (size_t i = 0; i < decorations.size(); ++i)
+	{
+		decor += Text::HTML(decorations[i]) + " ";
+	}
+
+	return decor;
+}
+
+std::string HTMLWriter::Minify(const std::string& html)
+{
+	std::string minified;
+	minified.reserve(html.length());
+
+	size_t pre_depth = 0;
+
+	for (size_t i = 0; i < html.length();)
+	{
+		if (html[i] == '<')
+		{
+			// Copy the tag, dropping the quotes around attribute values that are a single safe token.
+			const size_t end = html.find('>', i);
+			if (end == std::string::npos)
+			{
+				minified.append(html, i, std::string::npos);
+				break;
+			}
+
+			if (html.compare(i, 4, "<pre") == 0)
+				++pre_depth;
+			else if (html.compare(i, 5, "</pre") == 0 && pre_depth != 0)
+				--pre_depth;
+
+			for (size_t t = i; t <= end; ++t)
+			{
+				if (html[t] == '"' && t != i && html[t - 1] == '=')
+				{
+					const size_t close = html.find('"', t + 1);
+					if (close == std::string::npos || close > end)
+					{
+						minified.append(html, t, end + 1 - t);
+						break;
+					}
+
+					bool safe = close != t + 1;
+					for (size_t v = t + 1; v < close && safe; ++v)
+					{
+						const char c = html[v];
+						safe = std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_' || c == '.' || c == '#' || c == ':';
+					}
+
+					if (safe)
+						minified.append(html, t + 1, close - t - 1);
+					else
+						minified.append(html, t, close + 1 - t);
+
+					t = close;
+				}
+				else
+				{
+					minified += html[t];
+				}
+			}
+
+			i = end + 1;
+		}
+		else if (pre_depth == 0 && std::isspace(static_cast<unsigned char>(html[i])))
+		{
+			// Browsers render a run of whitespace outside of <pre> as one space.
+			minified += ' ';
+			while (i < html.length() && std::isspace(static_cast<unsigned char>(html[i])))
+			{
+				++i;
+			}
+		}
+		else
+		{
+			minified += html[i++];
+		}
+	}
+
+	return minified;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+
+#include "Writer.h"
+
+struct HTMLStyle;
+
+/*
+* Writes the documentation as .html files to Docs/HTML.
+* Minified pages are styled with the classes in CSS/MWUnityNamespace.css instead of
+  inline styles, and have their markup minified.
+*/
+class HTMLWriter : public Writer
+{
+
+public:
+
+	/*
+	* With measure, every minified page is also rendered unminified, only to count the bytes
+	  minify saved, for the run report. Measuring doubles the rendering of every page, so it
+	  is also done only when the savings are logged, at verbose.
+	*/
+	explicit HTMLWriter(const bool minify = false, const bool measure = false) : minify(minify), measure(measure), full_bytes(0), minified_bytes(0) {}
+
+	const char* Name() const override { return "HTML"; }
+	const char* Extension() const override { return ".html"; }
+	std::string OutputPath() const override;
+	VT(std::string) Assets() const override { return { "CSS/MWUnityNamespace.css" }; }
+
+	void RenderPage(std::ostream& html, const Page& page, const Site& site, const CrossReference& crefs) const override;
+
+	void RenderChangelog(std::ostream& html, const ApiChanges& changes, const CrossReference& crefs) const override;
+
+	/* With minify, reports the bytes of every minified page, and those saved if they were measured. */
+	void Summarise() const override;
+
+private:
+
+	void Render(std::ostream& html, const Page& page, const Site& site, const CrossReference& crefs, const HTMLStyle& style) const;
+
+	void RenderChanges(std::ostream& html, const ApiChanges& changes, const CrossReference& crefs, const HTMLStyle& style) const;
+
+	/* The nav links below node: every child, and the children of the ancestors of current, expanded. */
+	void RenderNav(std::ostream& html, const NamespaceTrie& namespaces, const size_t node, const size_t current, const HTMLStyle& style) const;
+	void RenderMember(std::ostream& html, const MW& mw, const CrossReference& crefs, const HTMLStyle& style) const;
+
+	std::string FormatInline(const InlineElement& element, const CrossReference& crefs) const override;
+	void AppendText(std::string& out, const char* raw, const size_t length) const override;
+
+	static std::string GetDecorations(const VT(std::string)& decorations);
+
+	/*
+	* Removes the quotes from attribute values that do not need them and collapses
+	  whitespace in text, except inside <pre>.
+	*/
+	static std::string Minify(const std::string& html);
+
+	const bool minify;
+	const bool measure;
+
+	// The size of every page without and with minify. full_bytes is only counted while measuring.
+	mutable std::atomic<size_t> full_bytes;
+	mutable std::atomic<size_t> minified_bytes;
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/*
+* A fast, stable, non-cryptographic hash of content. The same bytes always hash
+  to the same value, on every platform and across runs.
+*/
+class Hash
+{
+
+public:
+
+	/* 64-bit FNV-1a of length bytes at data. Pass a previous hash to continue hashing from it. */
+	static uint64_t Of(const char* data, const size_t length, uint64_t hash = 14695981039346656037ull)
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	static uint64_t Of(const std::string& content) { return Of(content.data(), content.size()); }
+
+	/* hash as 16 lowercase hexadecimal digits. */
+	static std::string Hex(const uint64_t hash)
+	{
+		char hex[17];
+		std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(hash));
+		return hex;
+	}
+
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/*
+* Inline documentation elements, <see>, <seealso>, <paramref>, <typeparamref> and <c>,
+  are kept inside the text of an MW record so that each Writer can decide how to
+  present them.
+*
+* An inline element is stored as:
+*	INLINE_BEGIN Kind Target [INLINE_LABEL Label] INLINE_END
+*
+* Where Target is the raw cref (E.g., M:MW.MArray`1.Push(`0)) or the name of the
+  parameter, and Label is the optional text written between the opening and closing tags.
+*/
+#define INLINE_BEGIN '\x01'
+#define INLINE_LABEL '\x02'
+#define INLINE_END '\x03'
+
+enum class EInline : char
+{
+	See = 'S',
+	SeeAlso = 'A',
+	ParamRef = 'P',
+	TypeParamRef = 'T',
+	LangWord = 'L',
+	Code = 'C'
+};
+
+struct InlineElement
+{
+	EInline kind;
+	std::string target;
+	std::string label;
+
+	bool IsCref() const { return kind == EInline::See || kind == EInline::SeeAlso; }
+};
+
+class Inline
+{
+
+public:
+
+	static void Append(std::string& text, const EInline kind, const std::string& target, const std::string& label = "")
+	{
+		text += INLINE_BEGIN;
+		text += static_cast<char>(kind);
+		text += target;
+
+		if (label.length() != 0)
+		{
+			text += INLINE_LABEL;
+			text += label;
+		}
+
+		text += INLINE_END;
+	}
+
+	/*
+	* Walks text, calling on_text(const char* begin, size_t length) for plain text and
+	  on_element(const InlineElement&) for every inline element, in order.
+	*/
+	template <typename OnText, typename OnElement>
+	static void ForEach(std::string_view text, OnText on_text, OnElement on_element)
+	{
+		size_t plain = 0;
+
+		for (size_t i = text.find(INLINE_BEGIN); i != std::string_view::npos; i = text.find(INLINE_BEGIN, plain))
+		{
+			if (i != plain)
+				on_text(text.data() + plain, i - plain);
+
+			size_t end = text.find(INLINE_END, i);
+			if (end == std::string_view::npos || i + 1 == end)
+			{
+				// Malformed; treat the rest as plain text.
+				plain = i;
+				break;
+			}
+
+			InlineElement element;
+			element.kind = static_cast<EInline>(text[i + 1]);
+
+			size_t label = text.find(INLINE_LABEL, i);
+			if (label != std::string_view::npos && label < end)
+			{
+				element.target.assign(text, i + 2, label - (i + 2));
+				element.label.assign(text, label + 1, end - (label + 1));
+			}
+			else
+			{
+				element.target.assign(text, i + 2, end - (i + 2));
+			}
+
+			on_element(element);
+
+			plain = end + 1;
+		}
+
+		if (plain < text.length())
+			on_text(text.data() + plain, text.length() - plain);
+	}
+
+	static bool HasElements(std::string_view text)
+	{
+		return text.find(INLINE_BEGIN) != std::string_view::npos;
+	}
+
+};
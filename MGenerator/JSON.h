@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+/*
+* Helpers for writing JSON by hand.
+*/
+class JSON
+{
+
+public:
+
+	/* Appends value to json as a quoted, escaped JSON string. */
+	static void AppendString(std::string& json, std::string_view value)
+	{
+		json += '"';
+
+		for (char c : value)
+		{
+			switch (c)
+			{
+			case '"': json += "\\\""; break;
+			case '\\': json += "\\\\"; break;
+			case '\n': json += "\\n"; break;
+			case '\r': json += "\\r"; break;
+			case '\t': json += "\\t"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+				{
+					char escaped[8];
+					std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+					json += escaped;
+				}
+				else
+				{
+					json += c;
+				}
+				break;
+			}
+		}
+
+		json += '"';
+	}
+
+	static std::string Quote(const std::string& value)
+	{
+		std::string json;
+		AppendString(json, value);
+		return json;
+	}
+
+};
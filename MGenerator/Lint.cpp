@@ -0,0 +1,157 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <thread>
+
+#include "Lint.h"
+#include "JSON.h"
+#include "Log.h"
+#include "Phase.h"
+
+VT(LintFinding) Lint::Run(const VT(MW)& all_mw, const unsigned threads)
+{
+	const size_t workers = std::max<size_t>(1, std::min<size_t>(threads, all_mw.size()));
+	const size_t per_worker = (all_mw.size() + workers - 1) / std::max<size_t>(1, workers);
+
+	// Each worker checks a contiguous range of all_mw into its own findings.
+	VT(VT(LintFinding)) worker_findings(workers);
+	VT(std::thread) checkers;
+
+	for (size_t w = 0; w < workers; ++w)
+	{
+		const size_t begin = w * per_worker;
+		const size_t end = std::min(all_mw.size(), begin + per_worker);
+
+		checkers.emplace_back([&all_mw, &worker_findings, w, begin, end]()
+			{
+				PhaseScope process(EPhase::Process);
+
+				for (size_t i = begin; i < end; ++i)
+				{
+					Check(all_mw[i], worker_findings[w]);
+				}
+			});
+	}
+
+	for (auto& checker : checkers)
+	{
+		checker.join();
+	}
+
+	VT(LintFinding) findings;
+	for (auto& found : worker_findings)
+	{
+		findings.insert(findings.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+	}
+
+	std::sort(findings.begin(), findings.end(), [](const LintFinding& l, const LintFinding& r)
+		{
+			if (l.mw->mw_namespace != r.mw->mw_namespace) return l.mw->mw_namespace < r.mw->mw_namespace;
+			if (l.mw->mw_class != r.mw->mw_class) return l.mw->mw_class < r.mw->mw_class;
+			if (l.mw->doc_id != r.mw->doc_id) return l.mw->doc_id < r.mw->doc_id;
+			if (l.check != r.check) return l.check < r.check;
+			return l.detail < r.detail;
+		});
+
+	return findings;
+}
+
+void Lint::Check(const MW& mw, VT(LintFinding)& findings)
+{
+#if WRITE_NO_DECORATIONS
+	if (!mw.decorations.size() && mw.mw_type == MEMBER && mw.mw_name != "CONSTRUCTOR")
+	{
+		findings.push_back({ ELint::NoDecorations, &mw, "has no decorations" });
+	}
+#endif // WRITE_NO_DECORATIONS
+
+	if (IsBlank(mw.summary))
+	{
+		findings.push_back({ ELint::NoSummary, &mw, "has no summary" });
+	}
+
+	for (size_t i = 0; i < mw.name_count; ++i)
+	{
+		if (IsBlank(mw.ParameterDescription(i)))
+		{
+			findings.push_back({ ELint::NoParamDescription, &mw, "parameter " + std::string(mw.ParameterName(i)) + " has no description" });
+		}
+	}
+
+	// Implicit operators keep their types in MW::implicit, not in the signature's parameters.
+	if (mw.mw_type == MEMBER && mw.implicit.length() == 0 && mw.type_count != mw.name_count)
+	{
+		findings.push_back({ ELint::ParamCountMismatch, &mw,
+			std::to_string(mw.type_count) + " parameters in the signature, " + std::to_string(mw.name_count) + " documented" });
+	}
+}
+
+void Lint::Print(const VT(LintFinding)& findings)
+{
+	size_t counts[4] = {};
+
+	for (auto& finding : findings)
+	{
+		const MW& mw = *finding.mw;
+		// The doc_id, so that overloads are told apart by their parameters. E.g., M:MW.UI.C7.F4(System.Int32).
+		MLOG(Warning, '[' << Name(finding.check) << "] " << mw.doc_id << ' ' << finding.detail << '.');
+
+		++counts[static_cast<size_t>(finding.check)];
+	}
+
+	MLOG(Info, "Documentation checks complete! " << findings.size() << " finding/s: "
+		<< counts[0] << ' ' << Name(ELint::NoDecorations) << ", "
+		<< counts[1] << ' ' << Name(ELint::NoSummary) << ", "
+		<< counts[2] << ' ' << Name(ELint::NoParamDescription) << ", "
+		<< counts[3] << ' ' << Name(ELint::ParamCountMismatch) << ".\n");
+}
+
+bool Lint::WriteJSON(const VT(LintFinding)& findings, const std::string& path)
+{
+	std::string json = "{\"findings\":[";
+
+	for (size_t i = 0; i < findings.size(); ++i)
+	{
+		const LintFinding& finding = findings[i];
+
+		json += i != 0 ? ",\n" : "\n";
+		json += "{\"check\":";
+		JSON::AppendString(json, Name(finding.check));
+		json += ",\"id\":";
+		JSON::AppendString(json, finding.mw->doc_id);
+		json += ",\"namespace\":";
+		JSON::AppendString(json, finding.mw->mw_namespace);
+		json += ",\"class\":";
+		JSON::AppendString(json, finding.mw->mw_class);
+		json += ",\"name\":";
+		JSON::AppendString(json, finding.mw->mw_name);
+		json += ",\"detail\":";
+		JSON::AppendString(json, finding.detail);
+		json += '}';
+	}
+
+	json += "\n],\"count\":" + std::to_string(findings.size()) + "}\n";
+
+	std::ofstream file(path, std::ios_base::binary);
+	file.write(json.data(), json.size());
+
+	return !file.fail();
+}
+
+const char* Lint::Name(const ELint check)
+{
+	switch (check)
+	{
+	case ELint::NoDecorations: return "NoDecorations";
+	case ELint::NoSummary: return "NoSummary";
+	case ELint::NoParamDescription: return "NoParamDescription";
+	case ELint::ParamCountMismatch: return "ParamCountMismatch";
+	}
+
+	return "";
+}
+
+bool Lint::IsBlank(std::string_view text)
+{
+	return std::all_of(text.begin(), text.end(), [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+}
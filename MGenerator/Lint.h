@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MW.h"
+#include "MMacros.h"
+
+enum class ELint
+{
+	// A MEMBER, other than a constructor, without a <decorations> tag.
+	NoDecorations,
+	// An empty, or missing <summary> (or <docs>).
+	NoSummary,
+	// A <param> without a description.
+	NoParamDescription,
+	// The number of <param> tags is not the number of parameters in the signature.
+	ParamCountMismatch
+};
+
+struct LintFinding
+{
+	ELint check;
+	const MW* mw;
+	std::string detail;
+};
+
+/*
+* Checks the documentation of every MW after it has been parsed.
+* Checks run in parallel over the records, and the findings are reported once,
+  sorted, at the end.
+*/
+class Lint
+{
+
+public:
+
+	/* Runs every check over all_mw using threads threads. */
+	static VT(LintFinding) Run(const VT(MW)& all_mw, const unsigned threads);
+
+	/* Writes every finding, one per line, followed by a count of each check. */
+	static void Print(const VT(LintFinding)& findings);
+
+	/* Writes every finding to path as JSON. Returns false if path could not be written. */
+	static bool WriteJSON(const VT(LintFinding)& findings, const std::string& path);
+
+	static const char* Name(const ELint check);
+
+private:
+
+	static void Check(const MW& mw, VT(LintFinding)& findings);
+
+	static bool IsBlank(std::string_view text);
+
+};
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Log.h"
+
+std::atomic<int> Log::level_threshold{ static_cast<int>(ELogLevel::Info) };
+
+namespace
+{
+	struct LogEntry
+	{
+		uint64_t sequence;
+		std::string line;
+	};
+
+	/*
+	* A single-producer, single-consumer ring of log lines.
+	* The owning thread is the only producer and the writer thread is the only consumer.
+	*/
+	struct LogBuffer
+	{
+		static constexpr size_t CAPACITY = 1024;
+
+		LogEntry entries[CAPACITY];
+		std::atomic<size_t> head{ 0 };
+		std::atomic<size_t> tail{ 0 };
+
+		bool TryPush(LogEntry&& entry)
+		{
+			const size_t h = head.load(std::memory_order_relaxed);
+			if (h - tail.load(std::memory_order_acquire) == CAPACITY)
+				return false;
+
+			entries[h % CAPACITY] = std::move(entry);
+			head.store(h + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		void DrainInto(std::vector<LogEntry>& out)
+		{
+			size_t t = tail.load(std::memory_order_relaxed);
+			const size_t h = head.load(std::memory_order_acquire);
+
+			for (; t != h; ++t)
+			{
+				out.push_back(std::move(entries[t % CAPACITY]));
+			}
+
+			tail.store(t, std::memory_order_release);
+		}
+	};
+
+	struct LogWriter
+	{
+		// Guards buffers and the writer thread's lifetime. Only taken once per thread,
+		// when its buffer is registered, and by the writer thread.
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable drained;
+
+		std::vector<std::shared_ptr<LogBuffer>> buffers;
+		std::thread thread;
+
+		std::atomic<uint64_t> next_sequence{ 0 };
+		uint64_t written = 0;
+		std::atomic<bool> running{ false };
+		bool registered_stop = false;
+
+		void Run()
+		{
+			std::vector<LogEntry> batch;
+			std::string out;
+
+			std::unique_lock<std::mutex> lock(mutex);
+			while (true)
+			{
+				batch.clear();
+				for (auto& buffer : buffers)
+				{
+					buffer->DrainInto(batch);
+				}
+
+				if (batch.size() != 0)
+				{
+					lock.unlock();
+
+					std::sort(batch.begin(), batch.end(), [](const LogEntry& l, const LogEntry& r) { return l.sequence < r.sequence; });
+
+					out.clear();
+					for (auto& entry : batch)
+					{
+						out += entry.line;
+						out += '\n';
+					}
+
+					std::cout.write(out.data(), out.size());
+					std::cout.flush();
+
+					lock.lock();
+					written += batch.size();
+					drained.notify_all();
+					continue;
+				}
+
+				if (!running.load(std::memory_order_relaxed))
+					break;
+
+				wake.wait_for(lock, std::chrono::milliseconds(10));
+			}
+		}
+
+		LogBuffer& ThisThreadBuffer()
+		{
+			thread_local std::shared_ptr<LogBuffer> buffer;
+
+			if (!buffer)
+			{
+				buffer = std::make_shared<LogBuffer>();
+
+				std::lock_guard<std::mutex> lock(mutex);
+				buffers.push_back(buffer);
+			}
+
+			return *buffer;
+		}
+
+		/* Starts the writer thread if it is not running, E.g., before the first line or after Log::Stop. */
+		void Start()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (running.load(std::memory_order_relaxed))
+				return;
+
+			if (thread.joinable())
+				thread.join();
+
+			running.store(true, std::memory_order_release);
+			thread = std::thread(&LogWriter::Run, this);
+
+			if (!registered_stop)
+			{
+				registered_stop = true;
+				std::atexit(Log::Stop);
+			}
+		}
+	};
+
+	LogWriter& Writer()
+	{
+		static LogWriter writer;
+		return writer;
+	}
+}
+
+void Log::SetLevel(const ELogLevel level)
+{
+	level_threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+bool Log::ParseLevel(const std::string& level, ELogLevel& out_level)
+{
+	const std::pair<const char*, ELogLevel> levels[] = {
+		{ "error", ELogLevel::Error },
+		{ "warning", ELogLevel::Warning },
+		{ "info", ELogLevel::Info },
+		{ "verbose", ELogLevel::Verbose },
+		{ "trace", ELogLevel::Trace }
+	};
+
+	for (auto& l : levels)
+	{
+		if (level == l.first)
+		{
+			out_level = l.second;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void Log::Write(const ELogLevel level, std::string&& line)
+{
+	LogWriter& writer = Writer();
+	LogBuffer& buffer = writer.ThisThreadBuffer();
+
+	if (!writer.running.load(std::memory_order_acquire))
+		writer.Start();
+
+	LogEntry entry{ writer.next_sequence.fetch_add(1, std::memory_order_relaxed), std::move(line) };
+
+	// If the writer thread has fallen behind, wait for it instead of dropping the line.
+	while (!buffer.TryPush(std::move(entry)))
+	{
+		writer.wake.notify_one();
+		std::this_thread::yield();
+	}
+
+	if (level <= ELogLevel::Warning)
+		writer.wake.notify_one();
+}
+
+void Log::Flush()
+{
+	LogWriter& writer = Writer();
+
+	std::unique_lock<std::mutex> lock(writer.mutex);
+	if (!writer.thread.joinable())
+		return;
+
+	const uint64_t target = writer.next_sequence.load(std::memory_order_relaxed);
+
+	writer.wake.notify_one();
+	writer.drained.wait(lock, [&writer, target]() { return writer.written >= target; });
+}
+
+void Log::Stop()
+{
+	LogWriter& writer = Writer();
+
+	{
+		std::lock_guard<std::mutex> lock(writer.mutex);
+		if (!writer.thread.joinable())
+			return;
+
+		writer.running.store(false, std::memory_order_release);
+	}
+
+	writer.wake.notify_one();
+	writer.thread.join();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+enum class ELogLevel : int
+{
+	Error,
+	Warning,
+	Info,
+	Verbose,
+	Trace
+};
+
+/*
+* Buffered, leveled diagnostics for MGenerator.
+*
+* Every thread appends to its own lock-free buffer and a single writer thread drains
+  every buffer to std::cout in the order messages were written, so lines from
+  different threads never interleave.
+*
+* Use MLOG, which does not format its message if the level is disabled.
+*	MLOG(Verbose, page.name << ".html created.");
+*/
+class Log
+{
+
+public:
+
+	static bool Enabled(const ELogLevel level)
+	{
+		return static_cast<int>(level) <= level_threshold.load(std::memory_order_relaxed);
+	}
+
+	static void SetLevel(const ELogLevel level);
+
+	/* Parses error, warning, info, verbose or trace. Returns false if level is not one of them. */
+	static bool ParseLevel(const std::string& level, ELogLevel& out_level);
+
+	/* Queues line, without a trailing '\n', to be written by the writer thread. */
+	static void Write(const ELogLevel level, std::string&& line);
+
+	/* Blocks until every line written before this call is in std::cout. */
+	static void Flush();
+
+	/* Flushes and stops the writer thread. Called automatically at exit. */
+	static void Stop();
+
+private:
+
+	static std::atomic<int> level_threshold;
+
+};
+
+#define MLOG(level, message) do \
+{ \
+	if (Log::Enabled(ELogLevel::level)) \
+	{ \
+		std::ostringstream mlog_line; \
+		mlog_line << message; \
+		Log::Write(ELogLevel::level, mlog_line.str()); \
+	} \
+} while (0)
@@ -3,7 +3,6 @@
 // Build.
 
 #define BUILD !_DEBUG
-#define PRINT_DEBUG_MSGS 0
 #define WITH_VS _MSC_VER >= 1932
 
 // Shorthand.
@@ -18,11 +17,11 @@
 // Debug
 /* If we are debugging through the Visual Studio Debugger. */
 #define EXEC_FROM_VS 0
-/* Write the .html files that are created. */
-#define WRITE_CREATION_MESSAGES 0
 /* Write the line of .cpp code responsible for writing to the .html documentation file. */
 #define WRITE_DEBUG_LINES 0
 /* Write the class and MEMBER if it has no decorations. */
 #define WRITE_NO_DECORATIONS 1
 /* Time the creation of all Documentation files made by MGenerator. */
 #define WITH_TIMER 0
+/* Count allocations per EPhase by replacing the global operator new; see MemoryStats. */
+#define WITH_MEMORY_STATS 0
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cctype>
 #include <string>
 #include <vector>
 
 #include "MMacros.h"
+#include "Log.h"
+#include "ParameterStore.h"
 
 #define GENERATE_DEFAULTS() this->mw_type = mw_type;\
 this->mw_namespace = mw_namespace;\
@@ -16,19 +19,27 @@ struct MW
 {
 	std::string mw_type, mw_namespace, mw_class, mw_name;
 
+	// The raw documentation ID. E.g., M:MW.MArray`1.Push(`0).
+	std::string doc_id;
+
 	std::string summary;
 	std::string returns;
 	std::string remarks;
 
-	// Parameter information.
-	VT(std::string) function_parameters_type;
-	VT(std::string) function_parameters_name;
-	VT(std::string) function_parameters_desc;
+	// Parameter information, in parameter_store. See ParameterStore.
+	const ParameterStore* parameter_store = nullptr;
+	ParameterStore::Range parameters;
+	// The number of parameters in the signature, and the number of <param> tags.
+	uint32_t type_count = 0;
+	uint32_t name_count = 0;
 
 	std::string implicit;
 
 	VT(std::string) decorations;
 
+	// The crefs of every <seealso> written directly under this <member>.
+	VT(std::string) see_also;
+
 	MW() {}
 
 	MW(const std::string mw_type, std::string mw_namespace, std::string mw_class, std::string mw_name, std::string summary)
@@ -48,25 +59,59 @@ struct MW
 		return false;
 	}
 
-#if PRINT_DEBUG_MSGS
-#define VECTOR_SIZE(v) v.size()
+	/*
+	* The HTML id of this MW in its page, derived from doc_id.
+	* Characters that cannot appear in a URL fragment are replaced with '-'.
+	*/
+	std::string Anchor() const
+	{
+		std::string anchor = doc_id;
+
+		for (char& c : anchor)
+		{
+			if (!std::isalnum(static_cast<unsigned char>(c)) && c != '.' && c != '_')
+				c = '-';
+		}
+
+		return anchor;
+	}
 
-	void Print()
+	/* The type of the i'th parameter in the signature, or empty if i >= type_count. */
+	std::string_view ParameterType(const size_t i) const
 	{
-		std::cout << VECTOR_SIZE(function_parameters_type) << " " << VECTOR_SIZE(function_parameters_name) << " " << VECTOR_SIZE(function_parameters_desc) << " " << mw_namespace << " " << mw_class << " " << mw_name << '\n';
-		std::cout << mw_namespace << '.' << mw_class << "::" << mw_name << '\n';
-		std::cout << summary << '\n' << '\n';
+		return i < type_count ? parameter_store->Type(parameters.begin + static_cast<uint32_t>(i)) : std::string_view();
+	}
+
+	/* The name of the i'th <param>, or empty if i >= name_count. */
+	std::string_view ParameterName(const size_t i) const
+	{
+		return i < name_count ? parameter_store->Name(parameters.begin + static_cast<uint32_t>(i)) : std::string_view();
+	}
+
+	/* The description of the i'th <param>, or empty if i >= name_count. */
+	std::string_view ParameterDescription(const size_t i) const
+	{
+		return i < name_count ? parameter_store->Description(parameters.begin + static_cast<uint32_t>(i)) : std::string_view();
+	}
+
+
+	/* Traces this MW. Does nothing unless the log level is trace. */
+	void Print() const
+	{
+		if (!Log::Enabled(ELogLevel::Trace))
+			return;
+
+		MLOG(Trace, type_count << " " << name_count << " " << mw_namespace << " " << mw_class << " " << mw_name);
+		MLOG(Trace, mw_namespace << '.' << mw_class << "::" << mw_name);
+		MLOG(Trace, summary << '\n');
 
-		for (int i = 0; i < function_parameters_name.size(); ++i)
+		for (size_t i = 0; i < name_count; ++i)
 		{
-			std::cout << function_parameters_type[i] << ' ' << function_parameters_name[i] << '\n';
-			std::cout << function_parameters_desc[i] << '\n';
+			MLOG(Trace, ParameterType(i) << ' ' << ParameterName(i));
+			MLOG(Trace, ParameterDescription(i));
 		}
 
-		std::cout << '\n' << '\n';
+		MLOG(Trace, '\n');
 	}
-#else
-	void Print() {  }
-#endif
 };
 
@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "Manifest.h"
+#include "Hash.h"
+#include "JSON.h"
+#include "Log.h"
+#include "Phase.h"
+
+Manifest::Manifest(const std::string& directory) : Manifest(directory, true)
+{
+}
+
+Manifest::Manifest(const std::string& directory, const bool hashing) : directory(directory), stopping(!hashing)
+{
+	if (hashing)
+		hasher = std::thread(&Manifest::Run, this);
+}
+
+Manifest::~Manifest()
+{
+	Stop();
+}
+
+void Manifest::Add(const std::string& file, VT(std::string) namespaces, std::string content)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending.push_back({ file, std::move(namespaces), std::move(content) });
+	}
+
+	ready.notify_one();
+}
+
+void Manifest::Run()
+{
+	PhaseScope write(EPhase::Write);
+
+	for (;;)
+	{
+		Pending next;
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			ready.wait(lock, [this]() { return stopping || !pending.empty(); });
+
+			if (pending.empty())
+				return;
+
+			next = std::move(pending.front());
+			pending.pop_front();
+		}
+
+		// Only this thread touches entries until it is joined.
+		entries.push_back({ std::move(next.file), Hash::Hex(Hash::Of(next.content)), next.content.size(), std::move(next.namespaces) });
+	}
+}
+
+void Manifest::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	ready.notify_one();
+
+	if (hasher.joinable())
+		hasher.join();
+}
+
+bool Manifest::Finish(const char* name)
+{
+	Stop();
+
+	return Write(name);
+}
+
+bool Manifest::FinishFragment(const std::string& file_name, const char* name)
+{
+	Stop();
+
+	std::sort(entries.begin(), entries.end(), [](const Entry& l, const Entry& r) { return l.file < r.file; });
+
+	std::ofstream fragment(directory + file_name, std::ios_base::binary);
+	const std::string json = Serialise(entries);
+	fragment.write(json.data(), json.size());
+
+	if (fragment.fail())
+	{
+		MLOG(Error, "Failed to write the " << name << " manifest fragment to " << directory << file_name);
+		return false;
+	}
+
+	MLOG(Info, name << " manifest fragment: " << entries.size() << " files in " << file_name << '.');
+
+	return true;
+}
+
+bool Manifest::Merge(const std::string& directory, const VT(std::string)& fragments, const char* name)
+{
+	// Every entry is read already hashed, so there is nothing to hash.
+	Manifest merged(directory, false);
+
+	for (const std::string& fragment : fragments)
+	{
+		if (!LoadEntries(directory + fragment, merged.entries))
+		{
+			MLOG(Error, "Failed to read the " << name << " manifest fragment " << directory << fragment);
+			return false;
+		}
+	}
+
+	std::sort(merged.entries.begin(), merged.entries.end(), [](const Entry& l, const Entry& r) { return l.file < r.file; });
+
+	// A file written by more than one shard means the shards were not of the same MW.xml.
+	for (size_t i = 1; i < merged.entries.size(); ++i)
+	{
+		if (merged.entries[i].file == merged.entries[i - 1].file)
+		{
+			MLOG(Error, name << ": " << merged.entries[i].file << " is in more than one manifest fragment.");
+			return false;
+		}
+	}
+
+	return merged.Write(name);
+}
+
+std::string Manifest::Serialise(const VT(Entry)& entries)
+{
+	std::string manifest = "{\n\"files\":[";
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		const Entry& entry = entries[i];
+
+		manifest += i != 0 ? ",\n" : "\n";
+		manifest += "{\"file\":" + JSON::Quote(entry.file) + ",\"hash\":" + JSON::Quote(entry.hash) + ",\"size\":" + std::to_string(entry.size) + ",\"namespaces\":[";
+
+		for (size_t n = 0; n < entry.namespaces.size(); ++n)
+		{
+			manifest += n != 0 ? "," : "";
+			JSON::AppendString(manifest, entry.namespaces[n]);
+		}
+
+		manifest += "]}";
+	}
+
+	manifest += "\n]\n}\n";
+
+	return manifest;
+}
+
+bool Manifest::Write(const char* name)
+{
+	std::sort(entries.begin(), entries.end(), [](const Entry& l, const Entry& r) { return l.file < r.file; });
+
+	const std::string manifest_path = directory + "manifest.json";
+	std::map<std::string, std::string> previous = Load(manifest_path);
+
+	VT(std::string) added, changed, removed;
+
+	const std::string manifest = Serialise(entries);
+
+	for (const Entry& entry : entries)
+	{
+		auto found = previous.find(entry.file);
+		if (found == previous.end())
+		{
+			added.push_back(entry.file);
+		}
+		else
+		{
+			if (found->second != entry.hash)
+				changed.push_back(entry.file);
+
+			previous.erase(found);
+		}
+	}
+
+	// Whatever is left was in the previous manifest, but was not written this time.
+	for (auto& file : previous)
+	{
+		removed.push_back(file.first);
+	}
+
+	auto AppendList = [](std::string& json, const char* key, const VT(std::string)& files)
+	{
+		json += '"';
+		json += key;
+		json += "\":[";
+
+		for (size_t i = 0; i < files.size(); ++i)
+		{
+			json += i != 0 ? "," : "";
+			JSON::AppendString(json, files[i]);
+		}
+
+		json += ']';
+	};
+
+	std::string diff = "{\n";
+	AppendList(diff, "added", added);
+	diff += ",\n";
+	AppendList(diff, "changed", changed);
+	diff += ",\n";
+	AppendList(diff, "removed", removed);
+	diff += "\n}\n";
+
+	std::ofstream manifest_file(manifest_path, std::ios_base::binary);
+	manifest_file.write(manifest.data(), manifest.size());
+
+	std::ofstream diff_file(directory + "manifest-diff.json", std::ios_base::binary);
+	diff_file.write(diff.data(), diff.size());
+
+	if (manifest_file.fail() || diff_file.fail())
+	{
+		MLOG(Error, "Failed to write the " << name << " manifest to " << directory);
+		return false;
+	}
+
+	for (auto& file : added)
+		MLOG(Verbose, name << " added: " << file);
+	for (auto& file : changed)
+		MLOG(Verbose, name << " changed: " << file);
+	for (auto& file : removed)
+		MLOG(Verbose, name << " removed: " << file);
+
+	MLOG(Info, name << " manifest: " << entries.size() << " files, " << added.size() << " added, " << changed.size() << " changed, " << removed.size() << " removed.");
+
+	return true;
+}
+
+std::map<std::string, std::string> Manifest::Load(const std::string& path)
+{
+	std::map<std::string, std::string> file_to_hash;
+
+	std::ifstream file(path, std::ios_base::binary);
+	if (!file)
+		return file_to_hash;
+
+	std::string line, name, hash;
+	while (std::getline(file, line))
+	{
+		if (ReadString(line, "{\"file\":", name) && ReadString(line, "\"hash\":", hash))
+			file_to_hash[name] = hash;
+	}
+
+	return file_to_hash;
+}
+
+bool Manifest::LoadEntries(const std::string& path, VT(Entry)& entries)
+{
+	std::ifstream file(path, std::ios_base::binary);
+	if (!file)
+		return false;
+
+	std::string line;
+	while (std::getline(file, line))
+	{
+		Entry entry;
+		if (!ReadString(line, "{\"file\":", entry.file) || !ReadString(line, "\"hash\":", entry.hash))
+			continue;
+
+		const size_t size = line.find("\"size\":");
+		const size_t namespaces = line.find("\"namespaces\":[");
+		if (size == std::string::npos || namespaces == std::string::npos)
+			return false;
+
+		entry.size = static_cast<size_t>(std::strtoull(line.c_str() + size + 7, nullptr, 10));
+
+		for (size_t i = namespaces + 14; i < line.length() && line[i] == '"';)
+		{
+			entry.namespaces.emplace_back();
+			i = ReadString(line, i, entry.namespaces.back());
+
+			if (i < line.length() && line[i] == ',')
+				++i;
+		}
+
+		entries.push_back(std::move(entry));
+	}
+
+	return true;
+}
+
+bool Manifest::ReadString(const std::string& line, const char* key, std::string& value)
+{
+	const size_t at = line.find(key);
+	return at != std::string::npos && ReadString(line, at + std::char_traits<char>::length(key), value) != std::string::npos;
+}
+
+size_t Manifest::ReadString(const std::string& line, size_t at, std::string& value)
+{
+	value.clear();
+
+	if (at >= line.length() || line[at] != '"')
+		return std::string::npos;
+
+	// Undoes JSON::AppendString.
+	for (size_t i = at + 1; i < line.length(); ++i)
+	{
+		if (line[i] == '"')
+			return i + 1;
+
+		if (line[i] != '\\' || i + 1 >= line.length())
+		{
+			value += line[i];
+			continue;
+		}
+
+		switch (line[++i])
+		{
+		case 'n': value += '\n'; break;
+		case 'r': value += '\r'; break;
+		case 't': value += '\t'; break;
+		case 'u':
+			value += static_cast<char>(std::strtol(line.substr(i + 1, 4).c_str(), nullptr, 16));
+			i += 4;
+			break;
+		default: value += line[i]; break;
+		}
+	}
+
+	return std::string::npos;
+}
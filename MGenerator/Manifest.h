@@ -0,0 +1,104 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MMacros.h"
+
+/*
+* A list of every file written to one output directory, with a content hash, size
+  and the namespaces each file documents.
+*
+* Files are hashed on a separate thread while the Writer renders the next page.
+* Finish writes manifest.json and manifest-diff.json, the files added, changed and
+  removed since the previous manifest.json in the same directory, so that a
+  publish step only needs to upload the difference.
+*/
+class Manifest
+{
+
+public:
+
+	struct Entry
+	{
+		std::string file;
+		std::string hash;
+		size_t size;
+		VT(std::string) namespaces;
+	};
+
+	/* Starts hashing for files written to directory. */
+	explicit Manifest(const std::string& directory);
+	~Manifest();
+
+	Manifest(const Manifest&) = delete;
+	Manifest& operator=(const Manifest&) = delete;
+
+	/* Queues the written content of file, relative to the directory, to be hashed. */
+	void Add(const std::string& file, VT(std::string) namespaces, std::string content);
+
+	/* Waits for every queued file to be hashed, then writes the manifest and the diff. Returns false if either could not be written. */
+	bool Finish(const char* name);
+
+	/*
+	* Waits for every queued file to be hashed, then writes them to file_name in the directory
+	  as a fragment of the manifest, without a diff. See Shard.
+	*/
+	bool FinishFragment(const std::string& file_name, const char* name);
+
+	/*
+	* Writes the manifest and the diff of directory from the fragments written there by every
+	  shard, as Finish would have had every file been written by one run.
+	* Returns false if a fragment could not be read, two fragments have the same file, or
+	  the manifest could not be written.
+	*/
+	static bool Merge(const std::string& directory, const VT(std::string)& fragments, const char* name);
+
+private:
+
+	/* A manifest of directory that only hashes files Added to it if hashing. */
+	Manifest(const std::string& directory, const bool hashing);
+
+	struct Pending
+	{
+		std::string file;
+		VT(std::string) namespaces;
+		std::string content;
+	};
+
+	void Run();
+	void Stop();
+
+	/* Sorts entries by file, then writes the manifest and the diff. */
+	bool Write(const char* name);
+
+	/* The manifest of entries as JSON, one file per line. */
+	static std::string Serialise(const VT(Entry)& entries);
+
+	/* Reads the file to hash map of a manifest written by a previous run. Empty if there is none. */
+	static std::map<std::string, std::string> Load(const std::string& path);
+
+	/* Appends every entry of the manifest, or fragment, at path to entries. False if it could not be read. */
+	static bool LoadEntries(const std::string& path, VT(Entry)& entries);
+
+	/* Reads the JSON string value that follows key on line. */
+	static bool ReadString(const std::string& line, const char* key, std::string& value);
+	/* Reads the JSON string that begins at at on line, returning the index after it, or npos. */
+	static size_t ReadString(const std::string& line, size_t at, std::string& value);
+
+	std::string directory;
+
+	std::mutex mutex;
+	std::condition_variable ready;
+	std::deque<Pending> pending;
+	bool stopping;
+
+	VT(Entry) entries;
+	std::thread hasher;
+
+};
@@ -0,0 +1,94 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const char* path)
+{
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	file_handle = file;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size))
+		return;
+
+	size = static_cast<size_t>(file_size.QuadPart);
+	if (size == 0)
+	{
+		valid = true;
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping)
+		return;
+
+	mapping_handle = mapping;
+
+	data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	valid = data != nullptr;
+}
+
+MappedFile::~MappedFile()
+{
+	if (data)
+		UnmapViewOfFile(data);
+	if (mapping_handle)
+		CloseHandle(mapping_handle);
+	if (file_handle)
+		CloseHandle(file_handle);
+}
+
+#else
+
+MappedFile::MappedFile(const char* path)
+{
+	const int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return;
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) == 0)
+	{
+		size = static_cast<size_t>(file_stat.st_size);
+
+		if (size == 0)
+		{
+			valid = true;
+		}
+		else
+		{
+			void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (mapped != MAP_FAILED)
+			{
+				madvise(mapped, size, MADV_SEQUENTIAL);
+
+				data = static_cast<const char*>(mapped);
+				valid = true;
+			}
+		}
+	}
+
+	// The mapping stays valid after the descriptor is closed.
+	close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+	if (data)
+		munmap(const_cast<char*>(data), size);
+}
+
+#endif
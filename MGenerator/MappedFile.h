@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+/*
+* A read-only view of a file, mapped into memory.
+* The view is never written to, so every thread can read from it, and the pages
+  are shared with the OS page cache instead of being copied.
+*/
+class MappedFile
+{
+
+public:
+
+	explicit MappedFile(const char* path);
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/* False if the file could not be opened or mapped. An empty file is valid. */
+	bool IsValid() const { return valid; }
+
+	const char* Data() const { return data; }
+	size_t Size() const { return size; }
+
+private:
+
+	const char* data = nullptr;
+	size_t size = 0;
+	bool valid = false;
+
+#ifdef _WIN32
+	void* file_handle = nullptr;
+	void* mapping_handle = nullptr;
+#endif
+
+};
@@ -0,0 +1,271 @@
+#include <cctype>
+
+#include "MMacros.h"
+#include "MarkdownWriter.h"
+#include "ApiDiff.h"
+#include "MW.h"
+#include "CrossReference.h"
+#include "Inline.h"
+#include "Text.h"
+
+/*
+* SwapChars writes angle brackets in types and decorations as HTML entities, and
+  text from MW.xml keeps its entities.
+* Markdown code spans show entities literally, so decode them.
+*/
+static std::string Unescape(const std::string& text)
+{
+	return Text::Decoded(text);
+}
+
+static std::string GetDecorations(const VT(std::string)& decorations)
+{
+	std::string decor;
+
+	for (size_t i = 0; i < decorations.size(); ++i)
+	{
+		if (i != 0)
+			decor += ' ';
+
+		decor += Unescape(decorations[i]);
+	}
+
+	return decor;
+}
+
+#define MD_ANCHOR(anchor) "<a id=\"" << anchor << "\"></a>"
+#define MD_DECORATIONS(decorations) "`" << decorations << "`\n\n"
+#define MD_KEYWORD(keyword) "**" << keyword << "** "
+// Documentation IDs hold '`', so they are written in double backticks.
+#define MD_DOC_ID(title) "`` " << title << " ``"
+
+std::string MarkdownWriter::OutputPath() const
+{
+#if EXEC_FROM_VS
+	return "../Docs/Markdown/API/";
+#else
+	return "../../Docs/Markdown/API/";
+#endif
+}
+
+void MarkdownWriter::RenderPage(std::ostream& md, const Page& page, const Site& site, const CrossReference& crefs) const
+{
+	md << "# MW." << page.name << "\n";
+	md << "<!-- Generated by MGenerator from MW.xml. Changes to this file will be overwritten. -->\n\n";
+
+	for (const MW& mw : page)
+	{
+		RenderMember(md, mw, crefs);
+	}
+
+	// Links to the ancestors and siblings of this page. page is always one of site.pages.
+	md << "---\n\n";
+	RenderNav(md, site.namespaces, NamespaceTrie::Root(), site.namespaces.NodeOf(static_cast<size_t>(&page - site.pages.data())), 0);
+}
+
+void MarkdownWriter::RenderChangelog(std::ostream& md, const ApiChanges& changes, const CrossReference& crefs) const
+{
+	md << "# Changelog\n";
+	md << "<!-- Generated by MGenerator from two versions of MW.xml. Changes to this file will be overwritten. -->\n\n";
+
+	md << "## Added (" << changes.added.size() << ")\n\n";
+	for (const MW* mw : changes.added)
+	{
+		md << "- " << ApiDiff::Kind(*mw) << " [" << MD_DOC_ID(ApiDiff::Title(*mw)) << "](" << crefs.Link(*mw, Extension()) << ')';
+
+		if (mw->summary.length() != 0)
+			md << ": " << FormatParagraph(mw->summary, crefs);
+
+		md << '\n';
+	}
+
+	md << "\n## Removed (" << changes.removed.size() << ")\n\n";
+	for (const MW* mw : changes.removed)
+	{
+		md << "- " << ApiDiff::Kind(*mw) << ' ' << MD_DOC_ID(ApiDiff::Title(*mw)) << '\n';
+	}
+
+	md << "\n## Changed (" << changes.changed.size() << ")\n\n";
+	for (const ApiChange& change : changes.changed)
+	{
+		const MW& mw = *change.after;
+
+		md << "- " << ApiDiff::Kind(mw) << " [" << MD_DOC_ID(ApiDiff::Title(mw)) << "](" << crefs.Link(mw, Extension()) << "): "
+			<< (change.signature ? (change.documentation ? "signature and documentation" : "signature") : "documentation") << " changed.\n";
+
+		if (change.before->summary != mw.summary)
+		{
+			md << "  - " << MD_KEYWORD("Summary:") << FormatParagraph(mw.summary, crefs) << '\n';
+			md << "  - " << MD_KEYWORD("Was:") << FormatParagraph(change.before->summary, crefs) << '\n';
+		}
+	}
+}
+
+void MarkdownWriter::RenderNav(std::ostream& md, const NamespaceTrie& namespaces, const size_t node, const size_t current, const size_t depth) const
+{
+	for (size_t child : namespaces[node].children)
+	{
+		const NamespaceTrie::Node& nav = namespaces[child];
+
+		md << std::string(depth * 2, ' ') << "- ";
+
+		if (child == current)
+			md << "**" << nav.name << "**\n";
+		else if (nav.page != NamespaceTrie::NONE)
+			md << '[' << nav.name << "](" << nav.path << Extension() << ")\n";
+		else
+			md << nav.name << '\n';
+
+		if (namespaces.Contains(child, current))
+			RenderNav(md, namespaces, child, current, depth + 1);
+	}
+}
+
+void MarkdownWriter::RenderMember(std::ostream& md, const MW& mw, const CrossReference& crefs) const
+{
+	const std::string decorations = GetDecorations(mw.decorations);
+
+	const bool no_class = mw.mw_class.length() == 0;
+	const bool is_function = mw.mw_name.length() != 0 && (mw.type_count != 0 || mw.mw_type == MEMBER);
+	const bool is_variable = mw.mw_name.length() != 0 && !is_function && (no_class ^ (mw.mw_type == FIELD) ^ (mw.mw_type == PROPERTY));
+
+	if (!is_function && !is_variable)
+	{
+		// A class, struct, enum, etc.
+		const std::string& name = mw.mw_name.length() != 0
+			? mw.mw_name
+			: (mw.mw_class.length() != 0 ? mw.mw_class : mw.mw_namespace);
+
+		md << "## " << MD_ANCHOR(mw.Anchor()) << name << "\n\n";
+
+		if (decorations.length() != 0)
+			md << MD_DECORATIONS(decorations);
+
+		if (mw.summary.length() != 0)
+			md << FormatParagraph(mw.summary, crefs) << "\n\n";
+
+		if (mw.mw_name.length() != 0 && mw.remarks.length() != 0)
+			md << FormatParagraph(mw.remarks, crefs) << "\n\n";
+	}
+	else if (is_variable)
+	{
+		md << "### " << MD_ANCHOR(mw.Anchor()) << mw.mw_name << "\n\n";
+
+		if (decorations.length() != 0)
+			md << MD_DECORATIONS(decorations);
+
+		md << FormatParagraph(mw.summary, crefs) << "\n\n";
+
+		if (mw.remarks.length() != 0)
+			md << FormatParagraph(mw.remarks, crefs) << "\n\n";
+	}
+	else
+	{
+		// Like HTMLWriter, a function without types in its signature is written without parameters.
+		const VT(std::string) param_types = mw.type_count != 0 ? GetParameterTypes(mw) : VT(std::string)();
+
+		std::string signature = mw.implicit.length() != 0 && param_types.size() == 0 ? mw.implicit : mw.mw_name;
+		signature += " (";
+		for (size_t i = 0; i < param_types.size(); ++i)
+		{
+			if (i != 0)
+				signature += ", ";
+
+			signature += param_types[i] + ' ';
+			signature += mw.ParameterName(i);
+		}
+		signature += ')';
+
+		md << "### " << MD_ANCHOR(mw.Anchor()) << '`' << Unescape(signature) << "`\n\n";
+
+		if (decorations.length() != 0)
+			md << MD_DECORATIONS(decorations);
+
+		if (mw.summary.length() != 0)
+			md << MD_KEYWORD("Summary:") << FormatParagraph(mw.summary, crefs) << "\n\n";
+
+		if (mw.remarks.length() != 0)
+			md << MD_KEYWORD("Remarks:") << FormatParagraph(mw.remarks, crefs) << "\n\n";
+
+		bool has_params = false;
+		for (size_t i = 0; i < param_types.size(); ++i)
+		{
+			if (mw.ParameterDescription(i).length() == 0)
+				continue;
+
+			if (!has_params)
+			{
+				md << MD_KEYWORD("Params:") << "\n\n";
+				has_params = true;
+			}
+
+			md << "- `" << mw.ParameterName(i) << "`: " << FormatParagraph(mw.ParameterDescription(i), crefs) << '\n';
+		}
+
+		if (has_params)
+			md << '\n';
+
+		if (mw.returns.length() != 0)
+			md << MD_KEYWORD("Returns:") << FormatParagraph(mw.returns, crefs) << "\n\n";
+	}
+
+	if (mw.see_also.size() != 0)
+		md << MD_KEYWORD("See Also:") << GetSeeAlso(mw.see_also, crefs, ", ") << "\n\n";
+}
+
+std::string MarkdownWriter::FormatInline(const InlineElement& element, const CrossReference& crefs) const
+{
+	switch (element.kind)
+	{
+	case EInline::See:
+	case EInline::SeeAlso:
+	{
+		const MW* target = crefs.Resolve(element.target);
+		const std::string label = element.label.length() != 0 ? element.label : CrossReference::Label(element.target, target);
+
+		if (!target)
+			return '`' + Unescape(label) + '`';
+
+		return '[' + Text::HTML(label) + "](" + crefs.Link(*target, Extension()) + ')';
+	}
+	case EInline::ParamRef:
+	case EInline::TypeParamRef:
+	case EInline::LangWord:
+	case EInline::Code:
+		return '`' + Unescape(element.target) + '`';
+	}
+
+	return Text::HTML(element.target);
+}
+
+void MarkdownWriter::AppendText(std::string& out, const char* raw, const size_t length) const
+{
+	// Markdown renders HTML entities, and escaping '<' keeps text like List<T> from being read as a tag.
+	Text::AppendHTML(out, raw, length);
+}
+
+std::string MarkdownWriter::FormatParagraph(std::string_view text, const CrossReference& crefs) const
+{
+	const std::string formatted = FormatText(text, crefs);
+
+	std::string paragraph;
+	paragraph.reserve(formatted.length());
+
+	bool in_whitespace = true;
+	for (char c : formatted)
+	{
+		if (std::isspace(static_cast<unsigned char>(c)))
+		{
+			in_whitespace = true;
+			continue;
+		}
+
+		if (in_whitespace && paragraph.length() != 0)
+			paragraph += ' ';
+
+		paragraph += c;
+		in_whitespace = false;
+	}
+
+	return paragraph;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Writer.h"
+
+/*
+* Writes the documentation as .md files to Docs/Markdown/API, next to the
+  hand-written Markdown docs.
+*/
+class MarkdownWriter : public Writer
+{
+
+public:
+
+	const char* Name() const override { return "Markdown"; }
+	const char* Extension() const override { return ".md"; }
+	std::string OutputPath() const override;
+
+	void RenderPage(std::ostream& md, const Page& page, const Site& site, const CrossReference& crefs) const override;
+	void RenderChangelog(std::ostream& md, const ApiChanges& changes, const CrossReference& crefs) const override;
+
+private:
+
+	void RenderMember(std::ostream& md, const MW& mw, const CrossReference& crefs) const;
+
+	/* A nested list of the children of node, with the children of the ancestors of current. */
+	void RenderNav(std::ostream& md, const NamespaceTrie& namespaces, const size_t node, const size_t current, const size_t depth) const;
+
+	std::string FormatInline(const InlineElement& element, const CrossReference& crefs) const override;
+	void AppendText(std::string& out, const char* raw, const size_t length) const override;
+
+	/* Text from MW.xml with its line breaks and indentation collapsed, so it stays in one Markdown paragraph. */
+	std::string FormatParagraph(std::string_view text, const CrossReference& crefs) const;
+};
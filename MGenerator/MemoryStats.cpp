@@ -0,0 +1,181 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <string>
+
+#include "MemoryStats.h"
+#include "MMacros.h"
+#include "Log.h"
+#include "RunReport.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "Psapi.lib")
+#endif
+
+namespace
+{
+	struct AtomicPhaseStats
+	{
+		std::atomic<uint64_t> allocations{ 0 };
+		std::atomic<uint64_t> bytes{ 0 };
+		std::atomic<uint64_t> peak_live{ 0 };
+	};
+
+	AtomicPhaseStats phase_stats[static_cast<int>(EPhase::Count)];
+	std::atomic<uint64_t> live{ 0 };
+}
+
+#if WITH_MEMORY_STATS
+
+namespace
+{
+	// Every allocation is prefixed with its size. 16 bytes keeps the default new alignment.
+	constexpr size_t HEADER = 16;
+
+	void* CountedAlloc(size_t size) noexcept
+	{
+		void* block = std::malloc(size + HEADER);
+		if (!block)
+			return nullptr;
+
+		*static_cast<size_t*>(block) = size;
+
+		AtomicPhaseStats& stats = phase_stats[static_cast<int>(Phase::Current())];
+		stats.allocations.fetch_add(1, std::memory_order_relaxed);
+		stats.bytes.fetch_add(size, std::memory_order_relaxed);
+
+		const uint64_t now_live = live.fetch_add(size, std::memory_order_relaxed) + size;
+		uint64_t peak = stats.peak_live.load(std::memory_order_relaxed);
+		while (now_live > peak && !stats.peak_live.compare_exchange_weak(peak, now_live, std::memory_order_relaxed))
+		{
+		}
+
+		return static_cast<char*>(block) + HEADER;
+	}
+
+	void CountedFree(void* memory) noexcept
+	{
+		if (!memory)
+			return;
+
+		void* block = static_cast<char*>(memory) - HEADER;
+		live.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+
+		std::free(block);
+	}
+}
+
+void* operator new(size_t size)
+{
+	if (void* memory = CountedAlloc(size))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+	if (void* memory = CountedAlloc(size))
+		return memory;
+
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return CountedAlloc(size); }
+
+void operator delete(void* memory) noexcept { CountedFree(memory); }
+void operator delete[](void* memory) noexcept { CountedFree(memory); }
+void operator delete(void* memory, size_t) noexcept { CountedFree(memory); }
+void operator delete[](void* memory, size_t) noexcept { CountedFree(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { CountedFree(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { CountedFree(memory); }
+
+#endif // WITH_MEMORY_STATS
+
+MemoryStats::PhaseStats MemoryStats::Get(const EPhase phase)
+{
+	const AtomicPhaseStats& stats = phase_stats[static_cast<int>(phase)];
+
+	PhaseStats copy;
+	copy.allocations = stats.allocations.load(std::memory_order_relaxed);
+	copy.bytes = stats.bytes.load(std::memory_order_relaxed);
+	copy.peak_live = stats.peak_live.load(std::memory_order_relaxed);
+
+	return copy;
+}
+
+size_t MemoryStats::PeakRSS()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return counters.PeakWorkingSetSize;
+
+	return 0;
+#else
+	// VmHWM is the peak resident set size, in kB.
+	FILE* status = std::fopen("/proc/self/status", "r");
+	if (!status)
+		return 0;
+
+	size_t peak_kb = 0;
+	char line[256];
+	while (std::fgets(line, sizeof(line), status))
+	{
+		if (std::strncmp(line, "VmHWM:", 6) == 0)
+		{
+			peak_kb = std::strtoull(line + 6, nullptr, 10);
+			break;
+		}
+	}
+
+	std::fclose(status);
+
+	return peak_kb * 1024;
+#endif
+}
+
+void MemoryStats::Report(const size_t members)
+{
+	const size_t peak_rss = PeakRSS();
+	const size_t per_member = members != 0 ? members : 1;
+
+#if WITH_MEMORY_STATS
+	MLOG(Info, std::left << std::setw(10) << "Phase" << std::right << std::setw(14) << "Allocations" << std::setw(16) << "Bytes" << std::setw(16) << "Peak Live" << std::setw(14) << "Bytes/Member");
+#endif
+
+	std::string json = "{\"members\":" + std::to_string(members) + ",\"peak_rss\":" + std::to_string(peak_rss);
+
+#if WITH_MEMORY_STATS
+	json += ",\"phases\":{";
+
+	for (int p = 0; p < static_cast<int>(EPhase::Count); ++p)
+	{
+		const EPhase phase = static_cast<EPhase>(p);
+		const PhaseStats stats = Get(phase);
+
+		MLOG(Info, std::left << std::setw(10) << Phase::Name(phase) << std::right << std::setw(14) << stats.allocations << std::setw(16) << stats.bytes << std::setw(16) << stats.peak_live << std::setw(14) << stats.bytes / per_member);
+
+		json += p != 0 ? "," : "";
+		json += '"' + std::string(Phase::Name(phase)) + "\":{\"allocations\":" + std::to_string(stats.allocations)
+			+ ",\"bytes\":" + std::to_string(stats.bytes)
+			+ ",\"peak_live\":" + std::to_string(stats.peak_live)
+			+ ",\"bytes_per_member\":" + std::to_string(stats.bytes / per_member) + '}';
+	}
+
+	json += '}';
+#endif
+
+	json += '}';
+
+	MLOG(Info, "Peak RSS: " << peak_rss / 1024 << " kB (" << peak_rss / per_member << " bytes/member).");
+
+	RunReport::Set("memory", json);
+}
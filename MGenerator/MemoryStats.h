@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Phase.h"
+
+/*
+* Counts allocations, bytes allocated and the peak of live bytes for each EPhase.
+*
+* Only counts if WITH_MEMORY_STATS is 1, which replaces the global operator new and
+  operator delete with versions that count.
+*/
+class MemoryStats
+{
+
+public:
+
+	struct PhaseStats
+	{
+		uint64_t allocations = 0;
+		uint64_t bytes = 0;
+		// The most bytes alive, across every thread, while any thread was in this phase.
+		uint64_t peak_live = 0;
+	};
+
+	static PhaseStats Get(const EPhase phase);
+
+	/* The peak resident set size of this process, in bytes, or 0 if it is unknown. */
+	static size_t PeakRSS();
+
+	/* Writes a table of every phase and adds a "memory" section to the RunReport. */
+	static void Report(const size_t members);
+
+};
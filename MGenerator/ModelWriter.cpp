@@ -0,0 +1,361 @@
+#include "ModelWriter.h"
+#include "ApiDiff.h"
+#include "CrossReference.h"
+#include "Inline.h"
+#include "JSON.h"
+#include "Manifest.h"
+#include "MW.h"
+#include "OutputSink.h"
+#include "Text.h"
+
+namespace
+{
+	/* Writes the model as JSON, leaving out empty fields. */
+	class JSONEncoder
+	{
+
+	public:
+
+		explicit JSONEncoder(std::string& out) : out(out), needs_comma{ false } {}
+
+		void BeginRecord(const char* key = nullptr)
+		{
+			Key(key);
+			out += '{';
+			needs_comma.push_back(false);
+		}
+
+		void EndRecord()
+		{
+			out += '}';
+			needs_comma.pop_back();
+		}
+
+		/* False if the list is left out. Only call EndList if true. */
+		bool BeginList(const char* key, const size_t count)
+		{
+			if (key && count == 0)
+				return false;
+
+			Key(key);
+			out += '[';
+			needs_comma.push_back(false);
+			return true;
+		}
+
+		void EndList()
+		{
+			out += ']';
+			needs_comma.pop_back();
+		}
+
+		void String(const char* key, std::string_view value)
+		{
+			if (key && value.empty())
+				return;
+
+			Key(key);
+			JSON::AppendString(out, value);
+		}
+
+		void Number(const char* key, const size_t value)
+		{
+			Key(key);
+			out += std::to_string(value);
+		}
+
+	private:
+
+		void Key(const char* key)
+		{
+			if (needs_comma.back())
+				out += ',';
+
+			needs_comma.back() = true;
+
+			if (key)
+			{
+				out += '"';
+				out += key;
+				out += "\":";
+			}
+		}
+
+		std::string& out;
+		VT(bool) needs_comma;
+
+	};
+
+	/* Writes the model as every field in order, without keys. */
+	class BinaryEncoder
+	{
+
+	public:
+
+		explicit BinaryEncoder(std::string& out) : out(out) { out += "MWM1"; }
+
+		void BeginRecord(const char* = nullptr) {}
+		void EndRecord() {}
+
+		bool BeginList(const char*, const size_t count)
+		{
+			Number(nullptr, count);
+			return count != 0;
+		}
+
+		void EndList() {}
+
+		void String(const char*, std::string_view value)
+		{
+			Number(nullptr, value.length());
+			out.append(value.data(), value.length());
+		}
+
+		/* LEB128. */
+		void Number(const char*, size_t value)
+		{
+			for (; value >= 0x80; value >>= 7)
+			{
+				out += static_cast<char>((value & 0x7F) | 0x80);
+			}
+
+			out += static_cast<char>(value);
+		}
+
+	private:
+
+		std::string& out;
+
+	};
+
+	/* Calls encode with the encoder of format and returns what it encoded. */
+	template <typename Encode>
+	std::string EncodeAs(const EModelFormat format, Encode encode)
+	{
+		std::string out;
+
+		if (format == EModelFormat::JSON)
+		{
+			JSONEncoder encoder(out);
+			encode(encoder);
+		}
+		else
+		{
+			BinaryEncoder encoder(out);
+			encode(encoder);
+		}
+
+		return out;
+	}
+}
+
+std::string ModelWriter::OutputPath() const
+{
+	const char* directory = format == EModelFormat::JSON ? "Model/" : "Model/Binary/";
+
+#if EXEC_FROM_VS
+	return std::string("../Docs/") + directory;
+#else
+	return std::string("../../Docs/") + directory;
+#endif
+}
+
+void ModelWriter::RenderPage(std::ostream& out, const Page& page, const Site&, const CrossReference& crefs) const
+{
+	out << EncodeAs(format, [&](auto& encoder)
+	{
+		encoder.BeginRecord();
+		encoder.String("ns", page.name);
+
+		if (encoder.BeginList("m", page.last - page.first))
+		{
+			for (const MW& mw : page)
+			{
+				EncodeMember(encoder, mw, crefs);
+			}
+
+			encoder.EndList();
+		}
+
+		encoder.EndRecord();
+	});
+}
+
+template <typename Encoder>
+void ModelWriter::EncodeMember(Encoder& encoder, const MW& mw, const CrossReference& crefs) const
+{
+	// As MarkdownWriter tells them apart.
+	const bool no_class = mw.mw_class.length() == 0;
+	const bool is_function = mw.mw_name.length() != 0 && (mw.type_count != 0 || mw.mw_type == MEMBER);
+	const bool is_variable = mw.mw_name.length() != 0 && !is_function && (no_class ^ (mw.mw_type == FIELD) ^ (mw.mw_type == PROPERTY));
+
+	encoder.BeginRecord();
+
+	encoder.String("a", mw.Anchor());
+	encoder.String("k", std::string_view(mw.doc_id).substr(0, 1));
+	encoder.Number("f", is_function ? 2 : is_variable ? 1 : 0);
+	encoder.String("c", mw.mw_class);
+	encoder.String("n", mw.mw_name);
+	encoder.String("t", mw.mw_type);
+	encoder.String("i", Text::Decoded(mw.implicit));
+
+	if (encoder.BeginList("d", mw.decorations.size()))
+	{
+		for (const std::string& decoration : mw.decorations)
+		{
+			encoder.String(nullptr, Text::Decoded(decoration));
+		}
+
+		encoder.EndList();
+	}
+
+	const VT(std::string) param_types = GetParameterTypes(mw);
+	if (encoder.BeginList("p", param_types.size()))
+	{
+		for (size_t i = 0; i < param_types.size(); ++i)
+		{
+			encoder.BeginList(nullptr, 3);
+			encoder.String(nullptr, Text::Decoded(param_types[i]));
+			encoder.String(nullptr, mw.ParameterName(i));
+			encoder.String(nullptr, FormatText(mw.ParameterDescription(i), crefs));
+			encoder.EndList();
+		}
+
+		encoder.EndList();
+	}
+
+	encoder.String("s", FormatText(mw.summary, crefs));
+	encoder.String("m", FormatText(mw.remarks, crefs));
+	encoder.String("r", FormatText(mw.returns, crefs));
+
+	if (encoder.BeginList("e", mw.see_also.size()))
+	{
+		for (const std::string& cref : mw.see_also)
+		{
+			InlineElement element;
+			element.kind = EInline::SeeAlso;
+			element.target = cref;
+
+			encoder.String(nullptr, FormatInline(element, crefs));
+		}
+
+		encoder.EndList();
+	}
+
+	encoder.EndRecord();
+}
+
+void ModelWriter::RenderChangelog(std::ostream& out, const ApiChanges& changes, const CrossReference& crefs) const
+{
+	// { "added": [ { k, t: title, l: link } ], "removed": [ { k, t } ], "changed": [ { k, t, l, g: signature, o: documentation } ] }
+	out << EncodeAs(format, [&](auto& encoder)
+	{
+		encoder.BeginRecord();
+
+		if (encoder.BeginList("added", changes.added.size()))
+		{
+			for (const MW* mw : changes.added)
+			{
+				encoder.BeginRecord();
+				encoder.String("k", ApiDiff::Kind(*mw));
+				encoder.String("t", ApiDiff::Title(*mw));
+				encoder.String("l", crefs.Link(*mw, ""));
+				encoder.EndRecord();
+			}
+
+			encoder.EndList();
+		}
+
+		if (encoder.BeginList("removed", changes.removed.size()))
+		{
+			for (const MW* mw : changes.removed)
+			{
+				encoder.BeginRecord();
+				encoder.String("k", ApiDiff::Kind(*mw));
+				encoder.String("t", ApiDiff::Title(*mw));
+				encoder.EndRecord();
+			}
+
+			encoder.EndList();
+		}
+
+		if (encoder.BeginList("changed", changes.changed.size()))
+		{
+			for (const ApiChange& change : changes.changed)
+			{
+				encoder.BeginRecord();
+				encoder.String("k", ApiDiff::Kind(*change.after));
+				encoder.String("t", ApiDiff::Title(*change.after));
+				encoder.String("l", crefs.Link(*change.after, ""));
+				encoder.Number("g", change.signature);
+				encoder.Number("o", change.documentation);
+				encoder.EndRecord();
+			}
+
+			encoder.EndList();
+		}
+
+		encoder.EndRecord();
+	});
+}
+
+bool ModelWriter::WriteIndex(const Site& site, OutputSink& sink, Manifest* manifest) const
+{
+	const std::string index = EncodeAs(format, [&](auto& encoder)
+	{
+		encoder.BeginRecord();
+
+		if (encoder.BeginList("pages", site.pages.size()))
+		{
+			for (const Page& page : site.pages)
+			{
+				encoder.BeginRecord();
+				encoder.String("n", page.name);
+				encoder.Number("m", page.last - page.first);
+				encoder.EndRecord();
+			}
+
+			encoder.EndList();
+		}
+
+		encoder.EndRecord();
+	});
+
+	const std::string file = std::string("_index") + Extension();
+	if (!sink.Write(OutputPath() + file, index))
+		return false;
+
+	// Hashed and diffed like a page, so that publishing uploads it whenever a namespace is added or removed.
+	if (manifest)
+		manifest->Add(file, {}, index);
+
+	return true;
+}
+
+std::string ModelWriter::FormatInline(const InlineElement& element, const CrossReference& crefs) const
+{
+	std::string encoded;
+
+	if (element.IsCref())
+	{
+		const MW* target = crefs.Resolve(element.target);
+		const std::string label = Text::Decoded(element.label.length() != 0 ? element.label : CrossReference::Label(element.target, target));
+
+		if (target)
+			Inline::Append(encoded, element.kind, crefs.Link(*target, ""), label);
+		else
+			Inline::Append(encoded, EInline::Code, label);
+	}
+	else
+	{
+		Inline::Append(encoded, element.kind, Text::Decoded(element.target), Text::Decoded(element.label));
+	}
+
+	return encoded;
+}
+
+void ModelWriter::AppendText(std::string& out, const char* raw, const size_t length) const
+{
+	// The browser escapes text as it renders it.
+	Text::AppendDecoded(out, raw, length);
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Writer.h"
+
+enum class EModelFormat
+{
+	// Compact JSON, one file per namespace.
+	JSON,
+	// The same fields in the same order, as length-prefixed strings and LEB128 numbers.
+	Binary
+};
+
+/*
+* Exports the documentation model itself instead of rendering it, for Docs/Model/index.html
+  to render in the browser.
+*
+* Every namespace is one file, { "ns": namespace, "m": [ member, ... ] }, and _index lists
+  every namespace with its number of members, { "pages": [ { "n": namespace, "m": count } ] }.
+* A member is:
+*	a	The anchor of the member in its page. See MW::Anchor.
+*	k	The kind, the first character of the documentation ID. E.g., M.
+*	f	0 for a type, 1 for a field or property, 2 for a method.
+*	c, n, t, i	The class, name, MW::mw_type and implicit operator.
+*	d	The decorations.
+*	p	The parameters, each [ type, name, description ], with types translated.
+*	s, m, r	The summary, remarks and returns.
+*	e	The <seealso>s.
+* Empty fields are left out of JSON. Binary writes every field, in the order above, after
+  the four bytes MWM1.
+* Text has its entities decoded and keeps its inline elements, encoded as in Inline.h, with
+  every resolved cref replaced by the namespace#anchor it links to. An unresolved cref is
+  written as code.
+*/
+class ModelWriter : public Writer
+{
+
+public:
+
+	explicit ModelWriter(const EModelFormat format = EModelFormat::JSON) : format(format) {}
+
+	const char* Name() const override { return format == EModelFormat::JSON ? "JSON" : "Binary"; }
+	const char* Extension() const override { return format == EModelFormat::JSON ? ".json" : ".mwb"; }
+	std::string OutputPath() const override;
+
+	/* The shell that renders the model, which reads the binary model from Binary/. */
+	VT(std::string) Assets() const override
+	{
+		if (format == EModelFormat::JSON)
+			return { "index.html" };
+
+		return {};
+	}
+
+	void RenderPage(std::ostream& out, const Page& page, const Site& site, const CrossReference& crefs) const override;
+	void RenderChangelog(std::ostream& out, const ApiChanges& changes, const CrossReference& crefs) const override;
+
+	/* Writes _index, every namespace and its number of members. */
+	bool WriteIndex(const Site& site, OutputSink& sink, Manifest* manifest) const override;
+
+private:
+
+	template <typename Encoder>
+	void EncodeMember(Encoder& encoder, const MW& mw, const CrossReference& crefs) const;
+
+	std::string FormatInline(const InlineElement& element, const CrossReference& crefs) const override;
+	void AppendText(std::string& out, const char* raw, const size_t length) const override;
+
+	const EModelFormat format;
+};
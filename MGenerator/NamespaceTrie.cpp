@@ -0,0 +1,101 @@
+#include <algorithm>
+
+#include "NamespaceTrie.h"
+#include "Writer.h"
+
+void NamespaceTrie::Build(const VT(Page)& all_pages)
+{
+	nodes.assign(1, Node());
+	page_nodes.assign(all_pages.size(), NONE);
+
+	for (size_t p = 0; p < all_pages.size(); ++p)
+	{
+		const std::string& name = all_pages[p].name;
+		size_t node = Root();
+
+		for (size_t begin = 0; begin <= name.length();)
+		{
+			size_t end = name.find('.', begin);
+			if (end == std::string::npos)
+				end = name.length();
+
+			const std::string part = name.substr(begin, end - begin);
+
+			// Pages are sorted, so a child, if it exists, is usually the most recent one.
+			size_t child = NONE;
+			for (auto c = nodes[node].children.rbegin(); c != nodes[node].children.rend(); ++c)
+			{
+				if (nodes[*c].name == part)
+				{
+					child = *c;
+					break;
+				}
+			}
+
+			if (child == NONE)
+			{
+				Node added;
+				added.name = part;
+				added.path = name.substr(0, end);
+				added.parent = node;
+
+				child = nodes.size();
+				nodes.push_back(std::move(added));
+				nodes[node].children.push_back(child);
+			}
+
+			node = child;
+			begin = end + 1;
+		}
+
+		nodes[node].page = p;
+		page_nodes[p] = node;
+	}
+
+	for (auto& node : nodes)
+	{
+		std::sort(node.children.begin(), node.children.end(), [this](size_t l, size_t r) { return nodes[l].name < nodes[r].name; });
+	}
+}
+
+size_t NamespaceTrie::Find(const std::string& namespace_path) const
+{
+	std::string path = namespace_path;
+	if (path == "MW")
+		return Root();
+
+	if (path.compare(0, 3, "MW.") == 0)
+		path.erase(0, 3);
+
+	for (size_t n = 1; n < nodes.size(); ++n)
+	{
+		if (nodes[n].path == path)
+			return n;
+	}
+
+	return NONE;
+}
+
+bool NamespaceTrie::Contains(const size_t ancestor, size_t node) const
+{
+	for (; node != NONE; node = nodes[node].parent)
+	{
+		if (node == ancestor)
+			return true;
+	}
+
+	return false;
+}
+
+VT(size_t) NamespaceTrie::Pages(const size_t node) const
+{
+	VT(size_t) pages;
+
+	for (size_t p = 0; p < page_nodes.size(); ++p)
+	{
+		if (Contains(node, page_nodes[p]))
+			pages.push_back(p);
+	}
+
+	return pages;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MMacros.h"
+
+struct Page;
+
+/*
+* Every namespace as a tree, split at each '.'. E.g., Math.Magic is the child Magic
+  of Math.
+*
+* A namespace without any MW of its own is still a node, so that its children have a
+  parent, but it has no page.
+*/
+class NamespaceTrie
+{
+
+public:
+
+	static constexpr size_t NONE = static_cast<size_t>(-1);
+
+	struct Node
+	{
+		// The last part of the namespace. E.g., Magic.
+		std::string name;
+		// The whole namespace, without MW. E.g., Math.Magic. Empty for the root.
+		std::string path;
+
+		// The index of this namespace's Page, or NONE.
+		size_t page = NONE;
+
+		size_t parent = NONE;
+		// Sorted by name.
+		VT(size_t) children;
+	};
+
+	/* Builds the tree of every page in all_pages, which must be sorted by name. */
+	void Build(const VT(Page)& all_pages);
+
+	/* The root, which is MW itself. */
+	static constexpr size_t Root() { return 0; }
+
+	const Node& operator[](const size_t node) const { return nodes[node]; }
+
+	/* The node of namespace, with or without the leading MW. E.g., MW.Math or Math. NONE if there is no such namespace. */
+	size_t Find(const std::string& namespace_path) const;
+
+	/* The node of the page at page_index. */
+	size_t NodeOf(const size_t page_index) const { return page_nodes[page_index]; }
+
+	/* Whether ancestor is node, or one of its ancestors. */
+	bool Contains(const size_t ancestor, size_t node) const;
+
+	/* The index of every page at or below node, in page order. */
+	VT(size_t) Pages(const size_t node) const;
+
+private:
+
+	VT(Node) nodes;
+	VT(size_t) page_nodes;
+
+};
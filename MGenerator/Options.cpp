@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#include "Options.h"
+#include "OutputSink.h"
+
+unsigned Options::Threads() const
+{
+	if (threads != 0)
+		return threads;
+
+	const unsigned hardware_threads = std::thread::hardware_concurrency();
+	return hardware_threads != 0 ? hardware_threads : 1;
+}
+
+PipelineConfig Options::Stages() const
+{
+	PipelineConfig config = PipelineConfig::For(Threads());
+
+	unsigned* stages[] = { &config.parse, &config.process, &config.render, &config.write };
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (stage_threads[i] != 0)
+			*stages[i] = stage_threads[i];
+	}
+
+	config.queue_depth = queue_depth != 0 ? queue_depth : 1;
+
+	return config;
+}
+
+bool Options::ParseFormats(const std::string& list, VT(std::string)& formats)
+{
+	VT(std::string) parsed;
+
+	// E.g., html,json.
+	for (size_t begin = 0; begin <= list.length();)
+	{
+		size_t end = list.find(',', begin);
+		if (end == std::string::npos)
+			end = list.length();
+
+		const std::string format = list.substr(begin, end - begin);
+		if (format != "html" && format != "markdown" && format != "json" && format != "binary")
+			return false;
+
+		if (std::find(parsed.begin(), parsed.end(), format) == parsed.end())
+			parsed.push_back(format);
+
+		begin = end + 1;
+	}
+
+	formats = parsed;
+	return true;
+}
+
+Options Options::Parse(int argc, char** argv)
+{
+	Options options;
+
+	int first = 1;
+
+	if (argc > 1 && std::string(argv[1]) == "serve")
+	{
+		options.command = ECommand::Serve;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "diff")
+	{
+		options.command = ECommand::Diff;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "benchmark")
+	{
+		options.command = ECommand::Benchmark;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "daemon")
+	{
+		options.command = ECommand::Daemon;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "build")
+	{
+		options.command = ECommand::Build;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "stop")
+	{
+		options.command = ECommand::Stop;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "merge")
+	{
+		options.command = ECommand::Merge;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "versions")
+	{
+		options.command = ECommand::Versions;
+		++first;
+	}
+	else if (argc > 1 && std::string(argv[1]) == "generate")
+	{
+		++first;
+	}
+
+	for (int i = first; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		const bool has_value = i + 1 < argc;
+
+		if (arg == "--base" && has_value)
+		{
+			options.base = argv[++i];
+		}
+		else if (arg == "--input" && has_value)
+		{
+			options.input = argv[++i];
+		}
+		else if (arg == "--formats" && has_value && ParseFormats(argv[i + 1], options.formats))
+		{
+			++i;
+		}
+		else if (arg == "--counters")
+		{
+			options.counters = true;
+		}
+		else if (arg == "--lint-json" && has_value)
+		{
+			options.lint_json = argv[++i];
+		}
+		else if (arg == "--cache-mb" && has_value)
+		{
+			options.cache_mb = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+		}
+		else if (arg == "--log-level" && has_value && Log::ParseLevel(argv[i + 1], options.log_level))
+		{
+			++i;
+		}
+		else if (arg == "--minify")
+		{
+			options.minify = true;
+		}
+		else if (arg == "--parser" && has_value && (std::string(argv[i + 1]) == "scanner" || std::string(argv[i + 1]) == "rapidxml"))
+		{
+			options.parser = std::string(argv[++i]) == "scanner" ? EParser::Scanner : EParser::RapidXML;
+		}
+		else if (arg == "--port" && has_value)
+		{
+			options.port = static_cast<unsigned short>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (arg == "--queue-depth" && has_value)
+		{
+			options.queue_depth = static_cast<size_t>(std::strtoull(argv[++i], nullptr, 10));
+		}
+		else if (arg == "--report" && has_value)
+		{
+			options.report = argv[++i];
+		}
+		else if (arg == "--subtree" && has_value)
+		{
+			options.subtree = argv[++i];
+		}
+		else if (arg == "--runs" && has_value)
+		{
+			options.runs = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (arg == "--shard" && has_value && Shard::Parse(argv[i + 1], options.shard))
+		{
+			++i;
+		}
+		else if (arg == "--sink" && has_value && OutputSink::Create(argv[i + 1]))
+		{
+			options.sink = argv[++i];
+		}
+		else if (arg == "--socket" && has_value)
+		{
+			options.socket = argv[++i];
+		}
+		else if (arg == "--stage-threads" && has_value)
+		{
+			// E.g., 2,2,3,1.
+			const char* counts = argv[++i];
+			for (size_t stage = 0; stage < 4 && *counts; ++stage)
+			{
+				char* end;
+				options.stage_threads[stage] = static_cast<unsigned>(std::strtoul(counts, &end, 10));
+				counts = *end == ',' ? end + 1 : end;
+			}
+		}
+		else if (arg == "--threads" && has_value)
+		{
+			options.threads = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (arg == "--versions" && has_value && Versions::Parse(argv[i + 1], options.versions))
+		{
+			++i;
+		}
+		else
+		{
+			std::cout << "Unknown or incomplete option: " << arg << "\n\n";
+			PrintUsage();
+			std::exit(-1);
+		}
+	}
+
+	if (options.command == ECommand::Diff && options.base.length() == 0)
+	{
+		std::cout << "diff needs the older MW.xml to compare against, with --base.\n\n";
+		PrintUsage();
+		std::exit(-1);
+	}
+
+	if (options.command == ECommand::Versions && options.versions.empty())
+	{
+		std::cout << "versions needs the name and MW.xml of every version, with --versions.\n\n";
+		PrintUsage();
+		std::exit(-1);
+	}
+
+	return options;
+}
+
+void Options::PrintUsage()
+{
+	std::cout << "Usage: MGenerator [generate | serve | diff | benchmark | daemon | build | stop | merge | versions] [options]\n";
+	std::cout << "\tgenerate\t\tWrite the documentation. The default.\n";
+	std::cout << "\tserve\t\t\tServe the HTML documentation at http://127.0.0.1:<port>/, rendering pages on request.\n";
+	std::cout << "\tdiff\t\t\tWrite a changelog of the members added, removed and changed since --base.\n";
+	std::cout << "\tbenchmark\t\tTime reading MW.xml with each parser, and check that they agree.\n";
+	std::cout << "\tdaemon\t\t\tStay resident, regenerating from the MW.xml sent by build over --socket.\n";
+	std::cout << "\tbuild\t\t\tAsk the daemon to regenerate from --input. Generates here if there is no daemon.\n";
+	std::cout << "\tstop\t\t\tStop the daemon.\n";
+	std::cout << "\tmerge\t\t\tMerge the manifest fragments of every --shard, once their pages are in one directory.\n";
+	std::cout << "\tversions\t\tWrite every version in --versions to Docs/Versions, storing identical pages once.\n\n";
+	std::cout << "\t--base <path>\t\tWith diff, the older MW.xml to compare against.\n";
+	std::cout << "\t--cache-mb <megabytes>\tWith serve, the memory used to cache rendered pages. 64 by default.\n";
+	std::cout << "\t--counters\t\tCount cycles, instructions, cache and branch misses of every phase, or wall and CPU time.\n";
+	std::cout << "\t--input <path | - | fd:N>\tRead MW.xml from path, standard input or a file descriptor.\n";
+	std::cout << "\t--formats <list>\tWhat to write: html, markdown, json or binary, separated by commas. html,markdown by default.\n";
+	std::cout << "\t--lint-json <path>\tWrite documentation lint findings as JSON to path.\n";
+	std::cout << "\t--log-level <level>\terror, warning, info (default), verbose or trace.\n";
+	std::cout << "\t--minify\t\tStyle HTML with CSS classes instead of inline styles, and minify it.\n";
+	std::cout << "\t--parser <parser>\tscanner (default) or rapidxml.\n";
+	std::cout << "\t--port <port>\t\tWith serve, the port to listen on. 8080 by default.\n";
+	std::cout << "\t--queue-depth <count>\tThe capacity of each queue between pipeline stages. 16 by default.\n";
+	std::cout << "\t--report <path>\t\tWrite a JSON summary of the run to path.\n";
+	std::cout << "\t--subtree <namespace>\tOnly write the pages at or below namespace. E.g., MW.Math.\n";
+	std::cout << "\t--runs <count>\t\tWith benchmark, the times each parser reads MW.xml. 5 by default.\n";
+	std::cout << "\t--shard <i/N>\t\tOnly write shard i of N of the pages, and a fragment of every manifest.\n";
+	std::cout << "\t--sink <sink>\t\tfile (default), memory, or null to measure rendering alone.\n";
+	std::cout << "\t--socket <path>\t\tThe daemon's UNIX domain socket. MGenerator.sock by default.\n";
+	std::cout << "\t--stage-threads <parse>,<process>,<render>,<write>\n\t\t\t\tThreads of each pipeline stage. 0 shares --threads between them.\n";
+	std::cout << "\t--threads <count>\tThreads used by parallel passes. 0 uses every hardware thread.\n";
+	std::cout << "\t--versions <name>=<path>,...\n\t\t\t\tWith versions, the name and MW.xml of every version, oldest first.\n";
+}
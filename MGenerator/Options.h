@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Log.h"
+#include "Pipeline.h"
+#include "Reader.h"
+#include "Shard.h"
+#include "Versions.h"
+
+/*
+* What MGenerator does, given by the first argument.
+*/
+enum class ECommand
+{
+	// Write the documentation of every Writer. The default.
+	Generate,
+	// Serve the HTML documentation on loopback, rendering pages on request. See PreviewServer.
+	Serve,
+	// Write a changelog of the members added, removed and changed since --base. See ApiDiff.
+	Diff,
+	// Time reading MW.xml with each EParser, and check that they agree.
+	Benchmark,
+	// Stay resident and regenerate whenever a client asks over --socket. See BuildServer.
+	Daemon,
+	// Ask the daemon at --socket to regenerate from --input, or generate in this process if there is none.
+	Build,
+	// Stop the daemon at --socket.
+	Stop,
+	// Merge the manifest fragments written by every --shard. See Shard.
+	Merge,
+	// Write every version in --versions side by side, storing identical pages once. See Versions.
+	Versions
+};
+
+/*
+* Command line options for MGenerator.
+* With no arguments, MGenerator behaves as it does when called from GenerateDocs.bat.
+*/
+struct Options
+{
+	// generate, serve, diff, benchmark, daemon, build, stop, merge or versions.
+	ECommand command = ECommand::Generate;
+
+	// --input <path>: Read MW.xml from path, from standard input with -, or from an open file descriptor with fd:N.
+	// Empty reads Reader::DefaultPath().
+	std::string input;
+
+	// --formats <list>: The Writer of each format to write, separated by commas: html, markdown, json or binary.
+	VT(std::string) formats = { "html", "markdown" };
+
+	// --counters: Count wall time, CPU time and hardware counters of every phase. See PhaseProfiler.
+	bool counters = false;
+
+	// --lint-json <path>: Write documentation lint findings as JSON to path instead of printing them.
+	std::string lint_json;
+
+	// --base <path>: With diff, the older MW.xml to compare --input against.
+	std::string base;
+
+	// --cache-mb <megabytes>: With serve, the most memory rendered pages are cached in.
+	size_t cache_mb = 64;
+
+	// --log-level <level>: error, warning, info, verbose or trace. Messages above this level are not formatted or written.
+	ELogLevel log_level = ELogLevel::Info;
+
+	// --minify: Style HTML pages with CSS classes instead of inline styles, and minify their markup.
+	bool minify = false;
+
+	// --parser <scanner | rapidxml>: How MW.xml is parsed.
+	EParser parser = EParser::Scanner;
+
+	// --port <port>: With serve, the loopback port to listen on.
+	unsigned short port = 8080;
+
+	// --queue-depth <count>: The capacity of every queue between pipeline stages.
+	size_t queue_depth = 16;
+
+	// --report <path>: Write a JSON summary of the run, such as memory use per phase, to path.
+	std::string report;
+
+	// --subtree <namespace>: Only write the pages at or below namespace. E.g., MW.Math.
+	std::string subtree;
+
+	// --runs <count>: With benchmark, the number of times each parser reads MW.xml.
+	unsigned runs = 5;
+
+	// --socket <path>: The UNIX domain socket of the daemon, relative to the working directory.
+	std::string socket = "MGenerator.sock";
+
+	// --shard <i/N>: Only write the pages of shard i of N, and a fragment of every manifest.
+	Shard shard;
+
+	// --sink <file | memory | null>: Where pages are written. See OutputSink.
+	std::string sink = "file";
+
+	// --stage-threads <parse>,<process>,<render>,<write>: The threads of each pipeline stage.
+	// A stage given as 0, or left out, gets its share of --threads.
+	unsigned stage_threads[4] = { 0, 0, 0, 0 };
+
+	// --threads <count>: The number of threads used by parallel passes. 0 uses every hardware thread.
+	unsigned threads = 0;
+
+	// --versions <name>=<path>,...: With versions, the name and MW.xml of every version, oldest first.
+	VT(VersionInput) versions;
+
+	/* The number of threads to use, resolving 0 to the number of hardware threads. */
+	unsigned Threads() const;
+
+	/* The threads of every pipeline stage and the depth of their queues. */
+	PipelineConfig Stages() const;
+
+	/* Parses argv. Prints the usage and terminates if an argument is not recognised. */
+	static Options Parse(int argc, char** argv);
+
+	static void PrintUsage();
+
+private:
+
+	/* Parses a comma separated list of formats into formats. False if one is not a format. */
+	static bool ParseFormats(const std::string& list, VT(std::string)& formats);
+};
@@ -0,0 +1,77 @@
+#include <cstdio>
+#include <filesystem>
+
+#include "OutputSink.h"
+
+std::unique_ptr<OutputSink> OutputSink::Create(const std::string& name)
+{
+	if (name == "file")
+		return std::unique_ptr<OutputSink>(new FileSink());
+
+	if (name == "memory")
+		return std::unique_ptr<OutputSink>(new MemorySink());
+
+	if (name == "null")
+		return std::unique_ptr<OutputSink>(new NullSink());
+
+	return nullptr;
+}
+
+bool FileSink::Write(const std::string& path, std::string_view content)
+{
+	FILE* file = std::fopen(path.c_str(), "wb");
+
+	if (!file)
+	{
+		// The directory may not exist yet.
+		std::error_code ignored;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ignored);
+
+		file = std::fopen(path.c_str(), "wb");
+		if (!file)
+			return false;
+	}
+
+	// Reused by every file written on this thread.
+	thread_local char buffer[256 * 1024];
+	std::setvbuf(file, buffer, _IOFBF, sizeof(buffer));
+
+	const bool written = std::fwrite(content.data(), 1, content.size(), file) == content.size();
+	const bool closed = std::fclose(file) == 0;
+
+	if (written && closed)
+		Count(content.size());
+
+	return written && closed;
+}
+
+bool MemorySink::Write(const std::string& path, std::string_view content)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pages[path].assign(content.data(), content.size());
+	}
+
+	Count(content.size());
+
+	return true;
+}
+
+bool MemorySink::Find(const std::string& path, std::string& content) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = pages.find(path);
+	if (found == pages.end())
+		return false;
+
+	content = found->second;
+	return true;
+}
+
+bool NullSink::Write(const std::string&, std::string_view content)
+{
+	Count(content.size());
+
+	return true;
+}
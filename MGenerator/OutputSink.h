@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+/*
+* Where a Writer's rendered files go.
+* Every sink counts the files and bytes written to it, so that rendering can be measured
+  without the filesystem. Write is thread-safe in every sink.
+*/
+class OutputSink
+{
+
+public:
+
+	virtual ~OutputSink() {}
+
+	/* The name given to --sink. E.g., file. */
+	virtual const char* Name() const = 0;
+
+	/* Writes content as the file at path. Returns false if it could not be written. */
+	virtual bool Write(const std::string& path, std::string_view content) = 0;
+
+	/* Whether files are written to disk, and so whether a manifest of them means anything. */
+	virtual bool IsPersistent() const { return false; }
+
+	size_t Files() const { return files; }
+	size_t Bytes() const { return bytes; }
+
+	/* The sink called name: file, memory or null. nullptr if there is no such sink. */
+	static std::unique_ptr<OutputSink> Create(const std::string& name);
+
+protected:
+
+	void Count(const size_t size)
+	{
+		++files;
+		bytes += size;
+	}
+
+private:
+
+	std::atomic<size_t> files{ 0 };
+	std::atomic<size_t> bytes{ 0 };
+
+};
+
+/*
+* Writes every file to disk through a large stdio buffer, creating its directory if needed.
+*/
+class FileSink : public OutputSink
+{
+
+public:
+
+	const char* Name() const override { return "file"; }
+	bool Write(const std::string& path, std::string_view content) override;
+	bool IsPersistent() const override { return true; }
+
+};
+
+/*
+* Keeps every file in memory, keyed by path. For tests, and for looking at output without
+  touching the disk.
+*/
+class MemorySink : public OutputSink
+{
+
+public:
+
+	const char* Name() const override { return "memory"; }
+	bool Write(const std::string& path, std::string_view content) override;
+
+	/* Copies the file at path into content. False if nothing was written to path. */
+	bool Find(const std::string& path, std::string& content) const;
+
+	/* Every file written, by path. Only call once nothing else is writing. */
+	const std::map<std::string, std::string>& Pages() const { return pages; }
+
+private:
+
+	mutable std::mutex mutex;
+	std::map<std::string, std::string> pages;
+
+};
+
+/*
+* Discards every file, only counting them, so that a run measures rendering alone.
+*/
+class NullSink : public OutputSink
+{
+
+public:
+
+	const char* Name() const override { return "null"; }
+	bool Write(const std::string& path, std::string_view content) override;
+
+};
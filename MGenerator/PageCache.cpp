@@ -0,0 +1,62 @@
+#include <sstream>
+
+#include "PageCache.h"
+
+bool PageCache::Find(const std::string& name, std::string& content)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = index.find(name);
+	if (found == index.end())
+	{
+		++misses;
+		return false;
+	}
+
+	++hits;
+
+	// Move to the front; the least recently used page is at the back.
+	pages.splice(pages.begin(), pages, found->second);
+	content = found->second->content;
+
+	return true;
+}
+
+void PageCache::Insert(const std::string& name, const std::string& content)
+{
+	if (content.size() > capacity)
+		return;
+
+	std::lock_guard<std::mutex> lock(mutex);
+
+	auto found = index.find(name);
+	if (found != index.end())
+	{
+		size -= found->second->content.size();
+		pages.erase(found->second);
+		index.erase(found);
+	}
+
+	while (size + content.size() > capacity && !pages.empty())
+	{
+		size -= pages.back().content.size();
+		index.erase(pages.back().name);
+		pages.pop_back();
+		++evictions;
+	}
+
+	pages.push_front({ name, content });
+	index[name] = pages.begin();
+	size += content.size();
+}
+
+std::string PageCache::Stats()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	std::ostringstream stats;
+	stats << pages.size() << " pages, " << size / 1024 << " kB of " << capacity / 1024 << " kB, "
+		<< hits << " hits, " << misses << " misses, " << evictions << " evictions";
+
+	return stats.str();
+}
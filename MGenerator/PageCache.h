@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/*
+* Rendered pages, keyed by name, bounded by the total size of the pages it holds.
+* When a new page does not fit, the least recently used pages are evicted first.
+* Thread-safe.
+*/
+class PageCache
+{
+
+public:
+
+	explicit PageCache(const size_t capacity_bytes) : capacity(capacity_bytes), size(0), hits(0), misses(0), evictions(0) {}
+
+	/* Copies the page called name into content. False if it is not cached. */
+	bool Find(const std::string& name, std::string& content);
+
+	/* Caches content as the page called name, evicting pages until it fits. A page larger than the capacity is not cached. */
+	void Insert(const std::string& name, const std::string& content);
+
+	/* E.g., 12 pages, 1228 kB of 65536 kB, 30 hits, 12 misses, 0 evictions. */
+	std::string Stats();
+
+private:
+
+	struct Entry
+	{
+		std::string name;
+		std::string content;
+	};
+
+	std::mutex mutex;
+
+	// Most recently used at the front.
+	std::list<Entry> pages;
+	std::unordered_map<std::string, std::list<Entry>::iterator> index;
+
+	const size_t capacity;
+	size_t size;
+
+	uint64_t hits, misses, evictions;
+
+};
@@ -0,0 +1,100 @@
+#include <filesystem>
+#include <vector>
+
+#include "PageStore.h"
+#include "Hash.h"
+#include "Log.h"
+#include "MMacros.h"
+
+PageStore::PageStore(const std::string& directory) : directory(directory), links(0), copies(0)
+{
+}
+
+std::string PageStore::Put(std::string_view content, const char* extension)
+{
+	// The first two digits are a directory, so that no directory holds every file.
+	const std::string hash = Hash::Hex(Hash::Of(content.data(), content.size()));
+	const std::string address = hash.substr(0, 2) + '/' + hash + '-' + std::to_string(content.size()) + extension;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (!addresses.insert(address).second)
+		{
+			++deduplicated;
+			return address;
+		}
+	}
+
+	// Stored by an earlier run. The size is part of the address, so a partly written file is written again.
+	std::error_code error;
+	if (std::filesystem::file_size(directory + address, error) == content.size() && !error)
+	{
+		++deduplicated;
+		return address;
+	}
+
+	if (!sink.Write(directory + address, content))
+	{
+		MLOG(Error, "Failed to store " << directory << address << ". Maybe permissions?");
+
+		std::lock_guard<std::mutex> lock(mutex);
+		addresses.erase(address);
+		return std::string();
+	}
+
+	return address;
+}
+
+bool PageStore::Link(const std::string& address, const std::string& path)
+{
+	std::error_code error;
+	std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+
+	std::filesystem::create_hard_link(directory + address, path, error);
+	if (!error)
+	{
+		++links;
+		return true;
+	}
+
+	// E.g., the tree is on another volume than the store.
+	if (copies == 0)
+		MLOG(Warning, "Cannot hard link " << path << " to the store: " << error.message() << ". Copying instead.");
+
+	error.clear();
+	std::filesystem::copy_file(directory + address, path, std::filesystem::copy_options::overwrite_existing, error);
+	if (error)
+	{
+		MLOG(Error, "Failed to link or copy " << path << " from " << directory << address << '.');
+		return false;
+	}
+
+	++copies;
+	return true;
+}
+
+size_t PageStore::Collect()
+{
+	VT(std::filesystem::path) unused;
+
+	std::error_code error;
+	for (auto& entry : std::filesystem::recursive_directory_iterator(directory, error))
+	{
+		if (!entry.is_regular_file(error))
+			continue;
+
+		const std::string address = entry.path().lexically_relative(directory).generic_string();
+		if (addresses.count(address) == 0)
+			unused.push_back(entry.path());
+	}
+
+	// Removed once iterating is done, so the iterator is never invalidated.
+	size_t removed = 0;
+	for (const std::filesystem::path& file : unused)
+	{
+		removed += std::filesystem::remove(file, error);
+	}
+
+	return removed;
+}
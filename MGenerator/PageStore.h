@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+#include "OutputSink.h"
+
+/*
+* A content-addressed store of rendered files, shared by every version of the documentation.
+*
+* A file is stored once, at an address made of the hash and size of its content, no matter
+  how many versions or formats have the same content. E.g., 3f/3f09a1c2b4d5e6f7-2048.html.
+* A version's tree references stored files by hard link, falling back to a copy where the
+  filesystem cannot link, so every tree can be served as an ordinary directory.
+*/
+class PageStore
+{
+
+public:
+
+	/* The store in directory, which ends in a '/'. Files stored by an earlier run are reused. */
+	explicit PageStore(const std::string& directory);
+
+	/* Stores content unless it is already stored, and returns its address. Empty if it could not be stored. Thread-safe. */
+	std::string Put(std::string_view content, const char* extension);
+
+	/* Links path to the file stored at address, creating its directory. False if it could be neither linked nor copied. */
+	bool Link(const std::string& address, const std::string& path);
+
+	/* Removes every stored file that was not Put by this run, and returns how many were removed. */
+	size_t Collect();
+
+	const std::string& Directory() const { return directory; }
+
+	/* Files written to the store, and their bytes, by this run. */
+	size_t Stored() const { return sink.Files(); }
+	size_t StoredBytes() const { return sink.Bytes(); }
+
+	/* Puts of a file that was already stored. */
+	size_t Deduplicated() const { return deduplicated; }
+
+	size_t Links() const { return links; }
+	size_t Copies() const { return copies; }
+
+private:
+
+	std::string directory;
+	FileSink sink;
+
+	// The address of every file Put by this run.
+	std::mutex mutex;
+	std::unordered_set<std::string> addresses;
+
+	std::atomic<size_t> deduplicated{ 0 };
+	size_t links;
+	size_t copies;
+
+};
@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cassert>
+
+#include "ParameterStore.h"
+#include "MW.h"
+
+void ParameterStore::Append(MW& mw, const VT(std::string)& signature_types, const VT(std::string)& param_names, const VT(std::string)& param_descriptions)
+{
+	const size_t rows = std::max(signature_types.size(), param_names.size());
+
+	mw.parameter_store = this;
+	mw.parameters.begin = static_cast<uint32_t>(type_ids.size());
+	mw.parameters.count = static_cast<uint32_t>(rows);
+	mw.type_count = static_cast<uint32_t>(signature_types.size());
+	mw.name_count = static_cast<uint32_t>(param_names.size());
+
+	for (size_t i = 0; i < rows; ++i)
+	{
+		type_ids.push_back(i < signature_types.size() ? Intern(signature_types[i]) : 0);
+		names.push_back(i < param_names.size() ? Store(param_names[i]) : Span());
+		descriptions.push_back(i < param_descriptions.size() ? Store(param_descriptions[i]) : Span());
+	}
+
+	assert(type_ids.size() == names.size() && names.size() == descriptions.size());
+}
+
+void ParameterStore::Gather(VT(MW)& members)
+{
+	size_t rows = 0;
+	for (auto& mw : members)
+	{
+		rows += mw.parameters.count;
+	}
+
+	ParameterStore gathered;
+	gathered.type_ids.reserve(rows);
+	gathered.names.reserve(rows);
+	gathered.descriptions.reserve(rows);
+
+	for (auto& mw : members)
+	{
+		const uint32_t begin = static_cast<uint32_t>(gathered.type_ids.size());
+
+		for (uint32_t row = mw.parameters.begin; row < mw.parameters.begin + mw.parameters.count; ++row)
+		{
+			gathered.CopyRow(*mw.parameter_store, row);
+		}
+
+		mw.parameters.begin = begin;
+	}
+
+	// Built separately, as this store may also be one of the sources.
+	*this = std::move(gathered);
+
+	for (auto& mw : members)
+	{
+		mw.parameter_store = this;
+	}
+}
+
+uint32_t ParameterStore::Intern(std::string_view type)
+{
+	auto found = type_index.find(std::string(type));
+	if (found != type_index.end())
+		return found->second;
+
+	const uint32_t id = static_cast<uint32_t>(types.size());
+	types.emplace_back(type);
+	type_index.emplace(types.back(), id);
+
+	return id;
+}
+
+ParameterStore::Span ParameterStore::Store(std::string_view text)
+{
+	Span span;
+	span.offset = static_cast<uint32_t>(arena.size());
+	span.length = static_cast<uint32_t>(text.size());
+
+	arena.append(text.data(), text.size());
+
+	return span;
+}
+
+void ParameterStore::CopyRow(const ParameterStore& other, const uint32_t row)
+{
+	type_ids.push_back(Intern(other.Type(row)));
+	names.push_back(Store(other.Name(row)));
+	descriptions.push_back(Store(other.Description(row)));
+}
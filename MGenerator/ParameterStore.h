@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "MMacros.h"
+
+struct MW;
+
+/*
+* The parameters of every MW, stored by column instead of as three vectors of strings
+  in each MW.
+*
+* A row is one parameter: its type from the signature, and its name and description
+  from its <param> tag. Types repeat, so they are interned. Names and descriptions
+  are spans of one arena. An MW owns a contiguous range of rows.
+*
+* Rows are only ever appended whole, so the three columns are always the same length.
+*/
+class ParameterStore
+{
+
+public:
+
+	struct Range
+	{
+		uint32_t begin = 0;
+		uint32_t count = 0;
+	};
+
+	ParameterStore() = default;
+	ParameterStore(const ParameterStore&) = delete;
+	ParameterStore& operator=(const ParameterStore&) = delete;
+	ParameterStore(ParameterStore&&) = default;
+	ParameterStore& operator=(ParameterStore&&) = default;
+
+	/*
+	* Appends the parameters of mw. signature_types are from the signature; param_names and
+	  param_descriptions are from the <param> tags, in the same order. The signature and the
+	  tags may not agree on the number of parameters; the missing fields are empty.
+	*/
+	void Append(MW& mw, const VT(std::string)& signature_types, const VT(std::string)& param_names, const VT(std::string)& param_descriptions);
+
+	/*
+	* Replaces this store with the rows of every MW in members, copied from whichever store
+	  holds them, in the order of members. Every MW is then pointed at this store, and
+	  consecutive MW have consecutive rows.
+	*/
+	void Gather(VT(MW)& members);
+
+	std::string_view Type(const uint32_t row) const { return types[type_ids[row]]; }
+	std::string_view Name(const uint32_t row) const { return Text(names[row]); }
+	std::string_view Description(const uint32_t row) const { return Text(descriptions[row]); }
+
+	size_t Rows() const { return type_ids.size(); }
+
+private:
+
+	struct Span
+	{
+		uint32_t offset = 0;
+		uint32_t length = 0;
+	};
+
+	uint32_t Intern(std::string_view type);
+	Span Store(std::string_view text);
+	std::string_view Text(const Span span) const { return std::string_view(arena.data() + span.offset, span.length); }
+
+	/* Appends row of other. */
+	void CopyRow(const ParameterStore& other, const uint32_t row);
+
+	// Columns. Every column has one entry per row.
+	VT(uint32_t) type_ids;
+	VT(Span) names;
+	VT(Span) descriptions;
+
+	// Every distinct type. types[0] is the empty type.
+	VT(std::string) types = { "" };
+	std::unordered_map<std::string, uint32_t> type_index = { { "", 0 } };
+
+	// The characters of every name and description.
+	std::string arena;
+
+};
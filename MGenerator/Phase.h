@@ -0,0 +1,89 @@
+#pragma once
+
+#include "PhaseProfiler.h"
+
+/*
+* The phases of a run of MGenerator. Instrumentation, such as MemoryStats and PhaseProfiler, is
+  attributed to the phase of the thread doing the work.
+*/
+enum class EPhase : int
+{
+	// Anything outside of the phases below. E.g., static initialisation.
+	Other,
+	// Opening MW.xml and finding the <member> chunks.
+	Load,
+	// SchemaScanner, or rapidxml with --parser rapidxml, parsing the chunks.
+	Parse,
+	// ProcessNode, tag extraction and everything done with the MW records before rendering.
+	Process,
+	// Writers rendering pages into memory.
+	Render,
+	// Writing rendered pages to their files.
+	Write,
+
+	Count
+};
+
+class Phase
+{
+
+public:
+
+	/* The phase of the calling thread. */
+	static EPhase Current() { return current; }
+
+	static const char* Name(const EPhase phase)
+	{
+		switch (phase)
+		{
+		case EPhase::Other: return "other";
+		case EPhase::Load: return "load";
+		case EPhase::Parse: return "parse";
+		case EPhase::Process: return "process";
+		case EPhase::Render: return "render";
+		case EPhase::Write: return "write";
+		default: return "";
+		}
+	}
+
+private:
+
+	friend class PhaseScope;
+
+	static inline thread_local EPhase current = EPhase::Other;
+
+};
+
+/*
+* Sets the phase of the calling thread until the end of the scope.
+*	PhaseScope parse(EPhase::Parse);
+*/
+class PhaseScope
+{
+
+public:
+
+	explicit PhaseScope(const EPhase phase) : previous(Phase::current)
+	{
+		if (PhaseProfiler::Enabled())
+			PhaseProfiler::Switch(previous);
+
+		Phase::current = phase;
+	}
+
+	~PhaseScope()
+	{
+		if (PhaseProfiler::Enabled())
+			PhaseProfiler::Switch(Phase::current);
+
+		Phase::current = previous;
+	}
+
+	PhaseScope(const PhaseScope&) = delete;
+	PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+
+	EPhase previous;
+
+};
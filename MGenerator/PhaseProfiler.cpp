@@ -0,0 +1,352 @@
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <string>
+
+#include "PhaseProfiler.h"
+#include "Log.h"
+#include "Phase.h"
+#include "RunReport.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef __linux__
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	struct AtomicSample
+	{
+		std::atomic<uint64_t> wall_ns{ 0 };
+		std::atomic<uint64_t> cpu_ns{ 0 };
+		std::atomic<uint64_t> counters[PhaseProfiler::Count];
+	};
+
+	AtomicSample phase_samples[static_cast<int>(EPhase::Count)];
+
+	// Whether each counter could be opened by Enable. A thread only reads the counters that could.
+	bool available[PhaseProfiler::Count] = {};
+	// Threads that could not open the available counters, so the counters are missing their work.
+	std::atomic<size_t> threads_without_counters{ 0 };
+
+	const char* const COUNTER_NAMES[PhaseProfiler::Count] = { "cycles", "instructions", "cache_misses", "branch_misses" };
+
+	uint64_t ThreadCPUNanoseconds()
+	{
+#ifdef _WIN32
+		FILETIME creation, exit, kernel, user;
+		if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+			return 0;
+
+		// In 100 ns.
+		const uint64_t kernel_time = (static_cast<uint64_t>(kernel.dwHighDateTime) << 32) | kernel.dwLowDateTime;
+		const uint64_t user_time = (static_cast<uint64_t>(user.dwHighDateTime) << 32) | user.dwLowDateTime;
+		return (kernel_time + user_time) * 100;
+#else
+		timespec now;
+		if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now) != 0)
+			return 0;
+
+		return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+#endif
+	}
+
+	/*
+	* The counters of one thread, as one perf_event_open group so that all of them are read
+	  with one read().
+	*/
+	class ThreadCounters
+	{
+
+	public:
+
+		ThreadCounters()
+		{
+			for (int c = 0; c < PhaseProfiler::Count; ++c)
+			{
+				slots[c] = -1;
+			}
+		}
+
+		~ThreadCounters()
+		{
+#ifdef __linux__
+			for (int fd : fds)
+			{
+				if (fd >= 0)
+					close(fd);
+			}
+#endif
+		}
+
+		ThreadCounters(const ThreadCounters&) = delete;
+		ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+		/* Opens the counters of the calling thread. Returns errno of the first that could not be opened, or 0. */
+		int Open(const bool* wanted)
+		{
+			int first_error = 0;
+			opened = true;
+
+#ifdef __linux__
+			static const uint64_t CONFIGS[PhaseProfiler::Count] =
+			{
+				PERF_COUNT_HW_CPU_CYCLES,
+				PERF_COUNT_HW_INSTRUCTIONS,
+				PERF_COUNT_HW_CACHE_MISSES,
+				PERF_COUNT_HW_BRANCH_MISSES
+			};
+
+			int leader = -1;
+			for (int c = 0; c < PhaseProfiler::Count; ++c)
+			{
+				if (!wanted[c])
+					continue;
+
+				perf_event_attr attr;
+				std::memset(&attr, 0, sizeof(attr));
+				attr.size = sizeof(attr);
+				attr.type = PERF_TYPE_HARDWARE;
+				attr.config = CONFIGS[c];
+				attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+				attr.disabled = leader < 0;
+				// Only this process's own work, which is all an unprivileged process may count.
+				attr.exclude_kernel = 1;
+				attr.exclude_hv = 1;
+
+				const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+				if (fd < 0)
+				{
+					if (first_error == 0)
+						first_error = errno;
+
+					continue;
+				}
+
+				if (leader < 0)
+					leader = fd;
+
+				slots[c] = opened_count++;
+				fds[c] = fd;
+			}
+
+			group = leader;
+			if (group >= 0)
+			{
+				ioctl(group, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+				ioctl(group, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+			}
+#else
+			first_error = -1;
+#endif
+
+			last = Read();
+			return first_error;
+		}
+
+		bool IsOpen() const { return opened; }
+
+		bool IsCounting(const int counter) const { return slots[counter] >= 0; }
+
+		PhaseProfiler::Sample Read() const
+		{
+			PhaseProfiler::Sample sample;
+			sample.wall_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+			sample.cpu_ns = ThreadCPUNanoseconds();
+
+#ifdef __linux__
+			struct
+			{
+				uint64_t count;
+				uint64_t time_enabled;
+				uint64_t time_running;
+				uint64_t values[PhaseProfiler::Count];
+			} group_read;
+
+			if (group >= 0 && read(group, &group_read, sizeof(group_read)) > 0)
+			{
+				// When counters are shared with other processes, each only runs part of the time.
+				const double scale = group_read.time_running != 0 ? static_cast<double>(group_read.time_enabled) / group_read.time_running : 1.0;
+
+				for (int c = 0; c < PhaseProfiler::Count; ++c)
+				{
+					if (slots[c] >= 0 && static_cast<uint64_t>(slots[c]) < group_read.count)
+						sample.counters[c] = static_cast<uint64_t>(group_read.values[slots[c]] * scale);
+				}
+			}
+#endif
+
+			return sample;
+		}
+
+		/* Adds what this thread did since the last call to phase. */
+		void Attribute(const EPhase phase)
+		{
+			const PhaseProfiler::Sample now = Read();
+			AtomicSample& total = phase_samples[static_cast<int>(phase)];
+
+			// A scaled counter can read less than it did, so a negative difference is nothing.
+			auto Difference = [](const uint64_t now, const uint64_t last) { return now > last ? now - last : 0; };
+
+			total.wall_ns.fetch_add(Difference(now.wall_ns, last.wall_ns), std::memory_order_relaxed);
+			total.cpu_ns.fetch_add(Difference(now.cpu_ns, last.cpu_ns), std::memory_order_relaxed);
+
+			for (int c = 0; c < PhaseProfiler::Count; ++c)
+			{
+				total.counters[c].fetch_add(Difference(now.counters[c], last.counters[c]), std::memory_order_relaxed);
+			}
+
+			last = now;
+		}
+
+	private:
+
+		bool opened = false;
+		int group = -1;
+		int fds[PhaseProfiler::Count] = { -1, -1, -1, -1 };
+		// The index of each counter in a read of the group, or -1 if it is not open.
+		int slots[PhaseProfiler::Count];
+		int opened_count = 0;
+
+		PhaseProfiler::Sample last;
+
+	};
+
+	thread_local ThreadCounters thread_counters;
+}
+
+void PhaseProfiler::Enable()
+{
+	const bool all[Count] = { true, true, true, true };
+	const int error = thread_counters.Open(all);
+
+	// The counters the first thread could open are the ones every thread opens.
+	bool any = false;
+	for (int c = 0; c < Count; ++c)
+	{
+		available[c] = thread_counters.IsCounting(c);
+		any |= available[c];
+	}
+
+	if (error == 0)
+	{
+		MLOG(Info, "Counting cycles, instructions, cache misses and branch misses of every phase.");
+	}
+	else if (error == -1)
+	{
+		MLOG(Info, "Hardware counters are only read on Linux; counting wall and CPU time of every phase.");
+	}
+	else if (!any)
+	{
+		MLOG(Info, "Hardware counters cannot be opened (" << std::strerror(error) << "); counting wall and CPU time of every phase. Maybe perf_event_paranoid, or a container?");
+	}
+	else
+	{
+		MLOG(Info, "Some hardware counters cannot be opened (" << std::strerror(error) << "); counting those that can, and wall and CPU time of every phase.");
+	}
+
+	enabled = true;
+}
+
+void PhaseProfiler::Switch(const EPhase phase)
+{
+	if (!thread_counters.IsOpen())
+	{
+		bool wanted = false;
+		for (int c = 0; c < Count; ++c)
+		{
+			wanted |= available[c];
+		}
+
+		// Nothing was done in a phase on this thread before now.
+		if (thread_counters.Open(available) != 0 && wanted)
+			++threads_without_counters;
+
+		return;
+	}
+
+	thread_counters.Attribute(phase);
+}
+
+PhaseProfiler::Sample PhaseProfiler::Get(const EPhase phase)
+{
+	const AtomicSample& total = phase_samples[static_cast<int>(phase)];
+
+	Sample copy;
+	copy.wall_ns = total.wall_ns.load(std::memory_order_relaxed);
+	copy.cpu_ns = total.cpu_ns.load(std::memory_order_relaxed);
+
+	for (int c = 0; c < Count; ++c)
+	{
+		copy.counters[c] = total.counters[c].load(std::memory_order_relaxed);
+	}
+
+	return copy;
+}
+
+void PhaseProfiler::Report()
+{
+	if (!enabled)
+		return;
+
+	// What the calling thread did since its last phase.
+	thread_counters.Attribute(Phase::Current());
+
+	bool hardware = false;
+	for (int c = 0; c < Count; ++c)
+	{
+		hardware |= available[c];
+	}
+
+	if (hardware)
+		MLOG(Info, std::left << std::setw(10) << "Phase" << std::right << std::setw(12) << "Wall ms" << std::setw(12) << "CPU ms" << std::setw(16) << "Cycles"
+			<< std::setw(16) << "Instructions" << std::setw(8) << "IPC" << std::setw(14) << "Cache Misses" << std::setw(14) << "Branch Misses");
+	else
+		MLOG(Info, std::left << std::setw(10) << "Phase" << std::right << std::setw(12) << "Wall ms" << std::setw(12) << "CPU ms");
+
+	std::string json = std::string("{\"source\":") + (hardware ? "\"perf_event_open\"" : "\"clock\"") + ",\"threads_without_counters\":" + std::to_string(threads_without_counters) + ",\"phases\":{";
+
+	for (int p = 0; p < static_cast<int>(EPhase::Count); ++p)
+	{
+		const EPhase phase = static_cast<EPhase>(p);
+		const Sample sample = Get(phase);
+		const double ipc = sample.counters[Cycles] != 0 ? static_cast<double>(sample.counters[Instructions]) / sample.counters[Cycles] : 0.0;
+
+		if (hardware)
+			MLOG(Info, std::left << std::setw(10) << Phase::Name(phase) << std::right << std::fixed << std::setprecision(1) << std::setw(12) << sample.wall_ns / 1e6 << std::setw(12) << sample.cpu_ns / 1e6
+				<< std::setw(16) << sample.counters[Cycles] << std::setw(16) << sample.counters[Instructions] << std::setprecision(2) << std::setw(8) << ipc
+				<< std::setw(14) << sample.counters[CacheMisses] << std::setw(14) << sample.counters[BranchMisses]);
+		else
+			MLOG(Info, std::left << std::setw(10) << Phase::Name(phase) << std::right << std::fixed << std::setprecision(1) << std::setw(12) << sample.wall_ns / 1e6 << std::setw(12) << sample.cpu_ns / 1e6);
+
+		json += p != 0 ? "," : "";
+		json += '"' + std::string(Phase::Name(phase)) + "\":{\"wall_ns\":" + std::to_string(sample.wall_ns) + ",\"cpu_ns\":" + std::to_string(sample.cpu_ns);
+
+		// A counter that could not be opened is left out, rather than reported as 0.
+		for (int c = 0; c < Count; ++c)
+		{
+			if (available[c])
+				json += ",\"" + std::string(COUNTER_NAMES[c]) + "\":" + std::to_string(sample.counters[c]);
+		}
+
+		json += '}';
+	}
+
+	json += "}}";
+
+	if (threads_without_counters != 0)
+		MLOG(Warning, threads_without_counters << " threads could not open the hardware counters; their work is only in wall and CPU time.");
+
+	RunReport::Set("counters", json);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+enum class EPhase : int;
+
+/*
+* Counts what every thread does in each EPhase, given --counters: wall time, CPU time and,
+  on Linux, cycles, instructions, cache misses and branch misses from perf_event_open.
+*
+* Every PhaseScope attributes what its thread did since the last PhaseScope began or ended
+  to the phase it was in, so nested phases are not counted twice. Each thread opens its own
+  counters the first time it enters a phase.
+* Where the hardware counters cannot be opened, such as in most containers, only wall and
+  CPU time are counted. Wall time that is not CPU time was spent waiting, such as on I/O.
+*/
+class PhaseProfiler
+{
+
+public:
+
+	enum ECounter : int
+	{
+		Cycles,
+		Instructions,
+		CacheMisses,
+		BranchMisses,
+
+		Count
+	};
+
+	struct Sample
+	{
+		// Summed over every thread, so wall time may be more than the run took.
+		uint64_t wall_ns = 0;
+		uint64_t cpu_ns = 0;
+		uint64_t counters[Count] = {};
+	};
+
+	/* Starts counting on every thread. Logs why if the hardware counters cannot be used. */
+	static void Enable();
+
+	static bool Enabled() { return enabled; }
+
+	/* Attributes what the calling thread did since it last switched to phase. Called by PhaseScope. */
+	static void Switch(const EPhase phase);
+
+	static Sample Get(const EPhase phase);
+
+	/* Writes a table of every phase and adds a "counters" section to the RunReport. Does nothing unless enabled. */
+	static void Report();
+
+private:
+
+	static inline bool enabled = false;
+
+};
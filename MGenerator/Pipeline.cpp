@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <iomanip>
+
+#include "Pipeline.h"
+#include "Log.h"
+#include "RunReport.h"
+
+PipelineConfig PipelineConfig::For(const unsigned threads)
+{
+	const unsigned t = std::max(1u, threads);
+
+	PipelineConfig config;
+
+	// Building MW from the parsed XML costs about as much as the parse itself.
+	config.parse = std::max(1u, t / 2);
+	config.process = std::max(1u, t - config.parse);
+
+	// Rendering is most of the work; writing is mostly waiting on the disk.
+	config.write = std::max(1u, t / 4);
+	config.render = std::max(1u, t - config.write);
+
+	return config;
+}
+
+void Pipeline::Record(const char* producer, const char* consumer, const unsigned consumer_threads, const QueueStats& stats)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	entries.push_back({ producer, consumer, consumer_threads, stats });
+}
+
+void Pipeline::Report()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (entries.empty())
+		return;
+
+	MLOG(Info, std::left << std::setw(18) << "Queue" << std::right << std::setw(9) << "Threads" << std::setw(10) << "Items"
+		<< std::setw(10) << "Mean" << std::setw(8) << "Max" << std::setw(10) << "Full" << std::setw(10) << "Empty");
+
+	std::string json = "{\"queues\":[";
+	const Entry* fullest = nullptr;
+
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		const Entry& entry = entries[i];
+		const QueueStats& stats = entry.stats;
+
+		MLOG(Info, std::left << std::setw(18) << entry.producer + " -> " + entry.consumer << std::right << std::setw(9) << entry.consumer_threads
+			<< std::setw(10) << stats.pushes << std::setw(7) << std::fixed << std::setprecision(1) << stats.MeanOccupancy() << '/' << std::setw(2) << stats.capacity
+			<< std::setw(8) << stats.occupancy_max << std::setw(10) << stats.full_waits << std::setw(10) << stats.empty_waits);
+
+		json += i != 0 ? "," : "";
+		json += "{\"producer\":\"" + entry.producer + "\",\"consumer\":\"" + entry.consumer + "\""
+			+ ",\"consumer_threads\":" + std::to_string(entry.consumer_threads)
+			+ ",\"capacity\":" + std::to_string(stats.capacity)
+			+ ",\"items\":" + std::to_string(stats.pushes)
+			+ ",\"mean_occupancy\":" + std::to_string(stats.MeanOccupancy())
+			+ ",\"max_occupancy\":" + std::to_string(stats.occupancy_max)
+			+ ",\"full_waits\":" + std::to_string(stats.full_waits)
+			+ ",\"empty_waits\":" + std::to_string(stats.empty_waits) + '}';
+
+		if (!fullest || stats.MeanOccupancy() / stats.capacity > fullest->stats.MeanOccupancy() / fullest->stats.capacity)
+			fullest = &entry;
+	}
+
+	json += "]";
+
+	// A queue that stays nearly empty means its consumer keeps up; if every queue does, the
+	// producer of the first one is the limit.
+	if (fullest && fullest->stats.MeanOccupancy() * 4 >= fullest->stats.capacity)
+	{
+		MLOG(Info, "Slowest stage: " << fullest->consumer << ", its queue was " << std::fixed << std::setprecision(0)
+			<< fullest->stats.MeanOccupancy() * 100 / fullest->stats.capacity << "% full on average.");
+
+		json += ",\"bottleneck\":\"" + fullest->consumer + '"';
+	}
+
+	json += '}';
+
+	RunReport::Set("pipeline", json);
+
+	entries.clear();
+}
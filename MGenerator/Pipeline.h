@@ -0,0 +1,60 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BoundedQueue.h"
+#include "MMacros.h"
+
+/*
+* The number of threads of every stage of the pipeline, and the depth of the queues between them.
+* Reading is load -> parse -> process; MW.xml is loaded on the calling thread. Writing is
+  render -> write. The two halves are joined by sorting and cross-referencing, which need
+  every member.
+*/
+struct PipelineConfig
+{
+	unsigned parse = 1;
+	unsigned process = 1;
+	unsigned render = 1;
+	unsigned write = 1;
+
+	// The capacity of each queue between stages, in chunks or pages.
+	size_t queue_depth = 16;
+
+	/* Splits threads between the stages of each half of the pipeline. */
+	static PipelineConfig For(const unsigned threads);
+};
+
+/*
+* Collects how full every queue of the pipeline was, and reports the stage that held up the run.
+*/
+class Pipeline
+{
+
+public:
+
+	/* Records the stats of the queue from producer to consumer. Thread-safe. */
+	static void Record(const char* producer, const char* consumer, const unsigned consumer_threads, const QueueStats& stats);
+
+	/*
+	* Logs the occupancy of every recorded queue and writes the pipeline section of the run report.
+	* The consumer of the fullest queue, on average, is the slowest stage.
+	*/
+	static void Report();
+
+private:
+
+	struct Entry
+	{
+		std::string producer;
+		std::string consumer;
+		unsigned consumer_threads;
+		QueueStats stats;
+	};
+
+	static inline std::mutex mutex;
+	static inline VT(Entry) entries;
+
+};
@@ -0,0 +1,252 @@
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include "PreviewServer.h"
+#include "Log.h"
+#include "Socket.h"
+
+PreviewServer::PreviewServer(const VT(MW)& all_mw, const Writer& writer, const size_t cache_bytes) : writer(writer), cache(cache_bytes)
+{
+	crefs.Build(all_mw);
+	site = Writer::Paginate(all_mw);
+}
+
+int PreviewServer::Run(const unsigned short port)
+{
+	if (!Socket::Start())
+	{
+		MLOG(Error, "Failed to start Winsock.");
+		return -1;
+	}
+
+	socket_t listener = socket(AF_INET, SOCK_STREAM, 0);
+	if (listener == INVALID_SOCKET)
+	{
+		MLOG(Error, "Failed to create the preview server's socket.");
+		return -1;
+	}
+
+	int reuse = 1;
+	setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+	// Only ever listen on loopback; the preview is not meant to be reachable from elsewhere.
+	sockaddr_in address = {};
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 16) != 0)
+	{
+		MLOG(Error, "Failed to listen on 127.0.0.1:" << port << ". Is it already in use?");
+		CloseSocket(listener);
+		return -1;
+	}
+
+	crefs.Report();
+	MLOG(Info, "Serving " << site.pages.size() << " " << writer.Name() << " pages at http://127.0.0.1:" << port << "/");
+
+	// Connections are served by WORKERS threads, so one that is slow to send its request, such
+	// as a browser's speculative connection, holds up no other. One that sends nothing for
+	// RECEIVE_TIMEOUT_MS is dropped, so the workers are never all held up for long.
+	constexpr unsigned WORKERS = 8;
+	constexpr unsigned RECEIVE_TIMEOUT_MS = 5000;
+
+	auto Serve = [this](socket_t client)
+	{
+		// Only the request line is needed; the headers are read and ignored.
+		std::string request;
+		char buffer[4096];
+		while (request.find("\r\n\r\n") == std::string::npos && request.length() < 64 * 1024)
+		{
+			const int received = static_cast<int>(recv(client, buffer, sizeof(buffer), 0));
+			if (received <= 0)
+				break;
+
+			request.append(buffer, received);
+		}
+
+		// GET /Math.html HTTP/1.1
+		std::istringstream request_line(request.substr(0, request.find("\r\n")));
+		std::string method, path;
+		request_line >> method >> path;
+
+		std::string response;
+		if (method == "GET" || method == "HEAD")
+		{
+			response = Respond(path);
+
+			if (method == "HEAD")
+				response.erase(response.find("\r\n\r\n") + 4);
+		}
+		else if (method.length() != 0)
+		{
+			response = "HTTP/1.1 405 Method Not Allowed\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+		}
+
+		Socket::SendAll(client, response);
+		CloseSocket(client);
+	};
+
+	// Idle workers wait on the condition variable, rather than polling, as the preview is mostly idle.
+	std::mutex accepted_mutex;
+	std::condition_variable accepted_ready;
+	std::deque<socket_t> accepted;
+
+	// Respond only reads the site and crefs, and the cache is thread-safe.
+	VT(std::thread) workers;
+	for (unsigned w = 0; w < WORKERS; ++w)
+	{
+		workers.emplace_back([&]()
+		{
+			for (;;)
+			{
+				std::unique_lock<std::mutex> lock(accepted_mutex);
+				accepted_ready.wait(lock, [&]() { return !accepted.empty(); });
+
+				const socket_t client = accepted.front();
+				accepted.pop_front();
+				lock.unlock();
+
+				Serve(client);
+			}
+		});
+	}
+
+	for (;;)
+	{
+		socket_t client = accept(listener, nullptr, nullptr);
+		if (client == INVALID_SOCKET)
+			continue;
+
+		Socket::SetReceiveTimeout(client, RECEIVE_TIMEOUT_MS);
+
+		{
+			std::lock_guard<std::mutex> lock(accepted_mutex);
+			accepted.push_back(client);
+		}
+
+		accepted_ready.notify_one();
+	}
+}
+
+std::string PreviewServer::Respond(const std::string& raw_path)
+{
+	const std::string path = DecodePath(raw_path.substr(0, raw_path.find_first_of("?#")));
+
+	auto Response = [](const char* status, const std::string& content_type, const std::string& body)
+	{
+		return std::string("HTTP/1.1 ") + status + "\r\nContent-Type: " + content_type + "\r\nContent-Length: " + std::to_string(body.length())
+			+ "\r\nCache-Control: no-cache\r\nConnection: close\r\n\r\n" + body;
+	};
+
+	if (path == "/")
+	{
+		if (site.pages.empty())
+			return Response("404 Not Found", "text/plain", "There are no pages.");
+
+		return "HTTP/1.1 302 Found\r\nLocation: /" + site.pages.front().name + writer.Extension() + "\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+	}
+
+	// Never serve anything outside of the output directory.
+	if (path.find("..") != std::string::npos || path.find('\\') != std::string::npos)
+		return Response("403 Forbidden", "text/plain", "Forbidden.");
+
+	const std::string file = path.substr(1);
+	const std::string extension = writer.Extension();
+
+	std::string content;
+
+	if (file.length() > extension.length() && file.compare(file.length() - extension.length(), extension.length(), extension) == 0
+		&& GetPage(file.substr(0, file.length() - extension.length()), content))
+	{
+		return Response("200 OK", ContentType(file), content);
+	}
+
+	// Anything else, such as the stylesheets, is served as is from the output directory.
+	std::ifstream asset(writer.OutputPath() + file, std::ios_base::binary);
+	if (asset)
+	{
+		std::ostringstream read;
+		read << asset.rdbuf();
+		return Response("200 OK", ContentType(file), read.str());
+	}
+
+	MLOG(Verbose, "Preview: " << path << " was not found.");
+	return Response("404 Not Found", "text/plain", "Not found.");
+}
+
+bool PreviewServer::GetPage(const std::string& name, std::string& content)
+{
+	if (cache.Find(name, content))
+		return true;
+
+	// site.pages is sorted by name.
+	auto page = std::lower_bound(site.pages.begin(), site.pages.end(), name, [](const Page& p, const std::string& n) { return p.name < n; });
+	if (page == site.pages.end() || page->name != name)
+		return false;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	std::ostringstream rendered;
+	writer.RenderPage(rendered, *page, site, crefs);
+	content = rendered.str();
+
+	cache.Insert(name, content);
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	MLOG(Verbose, "Preview: rendered " << name << writer.Extension() << " in " << elapsed << "us. Cache: " << cache.Stats() << '.');
+
+	return true;
+}
+
+std::string PreviewServer::ContentType(const std::string& path)
+{
+	const std::string extension = path.substr(std::min(path.length(), path.rfind('.')));
+
+	if (extension == ".html")
+		return "text/html; charset=utf-8";
+	if (extension == ".md")
+		return "text/markdown; charset=utf-8";
+	if (extension == ".css")
+		return "text/css";
+	if (extension == ".js")
+		return "text/javascript";
+	if (extension == ".json")
+		return "application/json";
+	if (extension == ".png")
+		return "image/png";
+	if (extension == ".svg")
+		return "image/svg+xml";
+
+	return "application/octet-stream";
+}
+
+std::string PreviewServer::DecodePath(const std::string& path)
+{
+	// E.g., %60 to `.
+	std::string decoded;
+	decoded.reserve(path.length());
+
+	for (size_t i = 0; i < path.length(); ++i)
+	{
+		if (path[i] == '%' && i + 2 < path.length() && std::isxdigit(static_cast<unsigned char>(path[i + 1])) && std::isxdigit(static_cast<unsigned char>(path[i + 2])))
+		{
+			decoded += static_cast<char>(std::strtol(path.substr(i + 1, 2).c_str(), nullptr, 16));
+			i += 2;
+		}
+		else
+		{
+			decoded += path[i];
+		}
+	}
+
+	return decoded;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "CrossReference.h"
+#include "PageCache.h"
+#include "Writer.h"
+
+/*
+* Serves the documentation over HTTP on the loopback interface, for previewing.
+* Nothing is written to disk: a page is only rendered the first time it is requested
+  and is then kept in a PageCache. Any other file, such as CSS/, is read from the
+  Writer's OutputPath.
+* Connections are served by a few worker threads, and one that sends no request is dropped
+  after a timeout, so an idle connection does not hold up the others.
+*/
+class PreviewServer
+{
+
+public:
+
+	/* all_mw must outlive this PreviewServer and must not be resized. */
+	PreviewServer(const VT(MW)& all_mw, const Writer& writer, const size_t cache_bytes);
+
+	/* Serves http://127.0.0.1:port/ until the process is stopped. Returns non-zero if port could not be listened on. */
+	int Run(const unsigned short port);
+
+private:
+
+	/* The complete HTTP response to a GET of path. */
+	std::string Respond(const std::string& path);
+
+	/* The rendered page called name, from the cache or rendered now. False if there is no such page. */
+	bool GetPage(const std::string& name, std::string& content);
+
+	static std::string ContentType(const std::string& path);
+	static std::string DecodePath(const std::string& path);
+
+	const Writer& writer;
+	CrossReference crefs;
+	Site site;
+	PageCache cache;
+
+};
@@ -1,154 +1,827 @@
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <condition_variable>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 #include <sys/stat.h>
 
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
 #include "Reader.h"
 #include "SwapChars.h"
+#include "Inline.h"
+#include "Log.h"
+#include "MappedFile.h"
+#include "Phase.h"
+#include "Pipeline.h"
+#include "RunReport.h"
 
 #include "XML/rapidxml.hpp"
-#include "XML/rapidxml_print.hpp"
-#include "XML/rapidxml_utils.hpp"
 
 using namespace rapidxml;
 
 #include "MW.h"
 #include "MMacros.h"
+#include "ParameterStore.h"
+#include "SchemaScanner.h"
 
 #if BUILD
 #include "Timer.h"
 #endif
 
-std::vector<MW> Reader::OpenFile()
+const char* Reader::DefaultPath()
 {
-	std::vector<MW> all_mw;
-
 #if EXEC_FROM_VS
-	const char* xml_path = "../MW/Output/Binaries/Release/netstandard2.0/MW.xml";
+	return "../MW/Output/Binaries/Release/netstandard2.0/MW.xml";
 #else
-	const char* xml_path = "../../MW/Output/Binaries/Release/netstandard2.0/MW.xml";
+	return "../../MW/Output/Binaries/Release/netstandard2.0/MW.xml";
 #endif
+}
 
-	if (!FileExists(xml_path))
+std::vector<MW> Reader::OpenFile(const std::string& input, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser)
+{
+	std::vector<MW> all_mw;
+	std::string error;
+
+	if (!Read(input, pipeline, parameters, parser, all_mw, error))
 	{
-		std::cout << "The MW.xml file at: " << xml_path << " cannot be found, or opened!\n";
-		std::cout << "HTML Generator will now terminate!\n";
-#if !EXEC_FROM_VS
-		std::cout << std::endl;
-#endif
+		MLOG(Error, error);
+		MLOG(Error, "HTML Generator will now terminate!\n");
 		std::exit(-1);
 	}
 
-	file<> file(xml_path);
+	return all_mw;
+}
+
+bool Reader::Read(const std::string& input, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser, std::vector<MW>& all_mw, std::string& error)
+{
+	if (input == "-")
+		return OpenStream(0, "standard input", pipeline, parameters, parser, all_mw, error);
+
+	if (input.compare(0, 3, "fd:") == 0)
+		return OpenStream(std::atoi(input.c_str() + 3), input, pipeline, parameters, parser, all_mw, error);
+
+	const char* xml_path = input.length() != 0 ? input.c_str() : DefaultPath();
+
+	PhaseScope load(EPhase::Load);
+
+	if (!FileExists(xml_path))
+	{
+		error = std::string("The MW.xml file at: ") + xml_path + " cannot be found, or opened!";
+		return false;
+	}
+
+	// MW.xml is mapped read-only and never written to. The parse is non-destructive, so
+	// entities are only decoded, by a Writer, for text that is actually rendered.
+	MappedFile file(xml_path);
 
-	xml_document<>* doc = new xml_document<>();
-	doc->parse<0>(file.data());
+	if (!file.IsValid())
+	{
+		error = std::string("The MW.xml file at: ") + xml_path + " cannot be found, or opened!";
+		return false;
+	}
 
 	SwapChars::BuildTranslator();
 
-	xml_node<char>* members = doc->first_node()->first_node()->next_sibling();
+	const char* begin = file.Data();
+	const char* end = begin + file.Size();
+
+	// Everything between <members> and </members>.
+	const char* members_begin = Find(begin, end, "<members>");
+	const char* members_end = Find(members_begin, end, "</members>");
+
+	if (members_begin == end)
+	{
+		MLOG(Warning, "The MW.xml file at: " << xml_path << " has no <members>!");
+		all_mw.clear();
+		return true;
+	}
+
+	// A file cut off part way, e.g. while it is still being built, is not an empty MW.
+	if (members_end == end)
+	{
+		error = std::string("The MW.xml file at: ") + xml_path + " ends before </members>!";
+		return false;
+	}
+
+	members_begin += std::char_traits<char>::length("<members>");
+
+	// Split the members into chunks, each beginning at a top-level <member.
+	// There are more chunks than threads so that a thread with smaller members takes more chunks.
+	const size_t chunk_count = std::max<size_t>(1, (pipeline.parse + pipeline.process) * 4);
+	const size_t target_size = (members_end - members_begin) / chunk_count + 1;
+
+	auto Load = [&](const ChunkSink& sink)
+	{
+		for (const char* chunk = members_begin; chunk != members_end;)
+		{
+			const char* target = chunk + std::min<size_t>(target_size, members_end - chunk);
+			const char* next = target < members_end ? FindMember(target, members_end) : members_end;
+
+			// A span of the mapping, which outlives the pipeline.
+			sink(std::string_view(chunk, next - chunk), true, chunk - begin);
+			chunk = next;
+		}
+	};
+
+	return RunPipeline(xml_path, Load, pipeline, parameters, parser, all_mw, error);
+}
+
+/* The first field in which a and b differ, or nullptr if they are the same. */
+static const char* FirstDifference(const MW& a, const MW& b)
+{
+	if (a.doc_id != b.doc_id) return "doc_id";
+	if (a.mw_type != b.mw_type) return "type";
+	if (a.mw_namespace != b.mw_namespace) return "namespace";
+	if (a.mw_class != b.mw_class) return "class";
+	if (a.mw_name != b.mw_name) return "name";
+	if (a.implicit != b.implicit) return "implicit";
+	if (a.summary != b.summary) return "summary";
+	if (a.returns != b.returns) return "returns";
+	if (a.remarks != b.remarks) return "remarks";
+	if (a.decorations != b.decorations) return "decorations";
+	if (a.see_also != b.see_also) return "see_also";
+	if (a.type_count != b.type_count || a.name_count != b.name_count) return "parameter count";
+
+	for (size_t i = 0; i < std::max(a.type_count, a.name_count); ++i)
+	{
+		if (a.ParameterType(i) != b.ParameterType(i) || a.ParameterName(i) != b.ParameterName(i) || a.ParameterDescription(i) != b.ParameterDescription(i))
+			return "parameters";
+	}
+
+	return nullptr;
+}
+
+bool Reader::BenchmarkParsers(const std::string& input, const PipelineConfig& pipeline, const unsigned runs)
+{
+	if (input == "-" || input.compare(0, 3, "fd:") == 0)
+	{
+		MLOG(Error, "The parsers can only be benchmarked with a file, not " << input << '.');
+		return false;
+	}
+
+	const EParser parsers[] = { EParser::RapidXML, EParser::Scanner };
+	const char* names[] = { "rapidxml", "scanner" };
+
+	// Only the parse, from the text of <members> to MemberXML, on one thread.
+	double parse_fastest[2] = { 0, 0 };
+
+	{
+		MappedFile file(input.c_str());
+		if (!file.IsValid())
+		{
+			MLOG(Error, "The MW.xml file at: " << input << " cannot be found, or opened!");
+			return false;
+		}
+
+		const char* members_begin = Find(file.Data(), file.Data() + file.Size(), "<members>");
+		const char* members_end = Find(members_begin, file.Data() + file.Size(), "</members>");
+		if (members_end == file.Data() + file.Size())
+		{
+			MLOG(Error, "The MW.xml file at: " << input << " has no <members>!");
+			return false;
+		}
+
+		const std::string members(members_begin + std::char_traits<char>::length("<members>"), members_end);
+
+		for (unsigned run = 0; run < std::max(1u, runs); ++run)
+		{
+			for (size_t p = 0; p < 2; ++p)
+			{
+				size_t count = 0;
+				const auto start = std::chrono::steady_clock::now();
+
+				if (parsers[p] == EParser::RapidXML)
+				{
+					std::string text = members;
+					xml_document<> doc;
+					doc.parse<parse_non_destructive>(&text[0]);
+
+					// Kept, like the scanner keeps them, until every member of the chunk is built.
+					std::vector<MemberXML> read;
+					for (xml_node<>* member = doc.first_node(); member; member = member->next_sibling(), ++count)
+					{
+						read.emplace_back();
+						ReadMember(member, read.back());
+					}
+				}
+				else
+				{
+					std::vector<MemberXML> scanned;
+					SchemaScanner::Scan(members, 0, scanned);
+					count = scanned.size();
+				}
+
+				const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+				if (run == 0 || ms < parse_fastest[p])
+					parse_fastest[p] = ms;
+
+				MLOG(Verbose, names[p] << " parse " << run + 1 << ": " << count << " members in " << ms << " ms.");
+			}
+		}
+	}
+
+	ParameterStore parameters[2];
+	std::vector<MW> results[2];
+	double fastest[2] = { 0, 0 };
+
+	// Alternate the parsers, so that both see the same state of the page cache.
+	for (unsigned run = 0; run < std::max(1u, runs); ++run)
+	{
+		for (size_t p = 0; p < 2; ++p)
+		{
+			// The MW of the first run are kept for the comparison, and point into parameters[p].
+			ParameterStore later_parameters;
+			ParameterStore& run_parameters = run == 0 ? parameters[p] : later_parameters;
+
+			const auto start = std::chrono::steady_clock::now();
+			std::vector<MW> all_mw = OpenFile(input, pipeline, run_parameters, parsers[p]);
+			const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+			MLOG(Verbose, names[p] << " run " << run + 1 << ": " << ms << " ms.");
+
+			if (run == 0 || ms < fastest[p])
+				fastest[p] = ms;
+
+			if (run == 0)
+				results[p] = std::move(all_mw);
+		}
+	}
+
+	size_t different = 0;
+	const char* first_field = nullptr;
+	const MW* first_member = nullptr;
+
+	if (results[0].size() != results[1].size())
+	{
+		MLOG(Error, "rapidxml read " << results[0].size() << " members, but the scanner read " << results[1].size() << '.');
+		return false;
+	}
 
-	for (xml_node<>* member = members->first_node(); member; member = member->next_sibling())
+	for (size_t i = 0; i < results[0].size(); ++i)
 	{
-		xml_attribute<>* member_name_attribute = member->first_attribute("name");
+		if (const char* field = FirstDifference(results[0][i], results[1][i]))
+		{
+			if (different++ == 0)
+			{
+				first_field = field;
+				first_member = &results[0][i];
+			}
+		}
+	}
+
+	MLOG(Info, "Read " << results[0].size() << " members, fastest of " << std::max(1u, runs) << " runs. Parse only, on one thread, and all of OpenFile:");
+	MLOG(Info, "\trapidxml: " << parse_fastest[0] << " ms, " << fastest[0] << " ms.");
+	MLOG(Info, "\tscanner:  " << parse_fastest[1] << " ms (" << (parse_fastest[1] > 0 ? parse_fastest[0] / parse_fastest[1] : 0) << "x), "
+		<< fastest[1] << " ms (" << (fastest[1] > 0 ? fastest[0] / fastest[1] : 0) << "x).");
+
+	if (different != 0)
+		MLOG(Error, different << " members differ, the first is " << first_member->doc_id << " in its " << first_field << '.');
+	else
+		MLOG(Info, "Both parsers built the same members.");
+
+	RunReport::Set("parser", "{\"members\":" + std::to_string(results[0].size())
+		+ ",\"runs\":" + std::to_string(std::max(1u, runs))
+		+ ",\"rapidxml_parse_ms\":" + std::to_string(parse_fastest[0])
+		+ ",\"scanner_parse_ms\":" + std::to_string(parse_fastest[1])
+		+ ",\"rapidxml_ms\":" + std::to_string(fastest[0])
+		+ ",\"scanner_ms\":" + std::to_string(fastest[1])
+		+ ",\"different\":" + std::to_string(different) + '}');
+
+	return different == 0;
+}
 
-		MW m = ProcessNode(member_name_attribute->value());
+bool Reader::OpenStream(const int fd, const std::string& source, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser, std::vector<MW>& all_mw, std::string& error)
+{
+	PhaseScope load(EPhase::Load);
+
+#ifdef _WIN32
+	_setmode(fd, _O_BINARY);
+#endif
 
-		// Everything that appears in the docs has a summary, write it here.
-		m.summary = member->first_node()->value();
+	SwapChars::BuildTranslator();
+
+	// A chunk is handed to the parsers as soon as it holds at least STREAM_CHUNK_SIZE bytes of
+	// complete <member>s, so members are parsed while the producer is still writing the rest.
+	constexpr size_t STREAM_CHUNK_SIZE = 256 * 1024;
+	constexpr size_t READ_SIZE = 64 * 1024;
 
-		const std::string docs = "docs";
-		const std::string param = "param";
-		const std::string returns_default = "returns";
-		const std::string returns_custom = "docreturns";
-		const std::string remarks = "remarks";
-		const std::string doc_remarks = "docremarks";
-		const std::string decorations = "decorations";
+	// Long enough for FindMember to see "<members" whole at the end of what has been read.
+	constexpr size_t SLACK = 16;
 
-		/*
-		* When using tags that override the normal XML tags, ensure the custom
-		  tag is checked before the normal tag. Before writing values with the
-		  normal tag, check if the value's length is not zero.
+	bool in_members = false;
+	bool members_closed = false;
+	bool read_failed = false;
 
-		  See returns_custom and returns_default and doc_remarks and remarks
-		  for an example.
-		*/
+	// pending holds what has been read, but not yet handed to the parsers; it starts at byte offset.
+	std::string pending;
+	size_t offset = 0;
 
-		for (xml_node<>* summary_params_etc = member->first_node(); summary_params_etc; summary_params_etc = summary_params_etc->next_sibling())
+	auto Load = [&](const ChunkSink& sink)
+	{
+		auto Dispatch = [&](const size_t length)
 		{
+			// pending is reused for what is read next, so the chunk is copied.
+			sink(std::string_view(pending.data(), length), false, offset);
 
-			const std::string this_name = summary_params_etc->name();
+			pending.erase(0, length);
+			offset += length;
+		};
+
+		std::vector<char> block(READ_SIZE);
+
+		while (!members_closed)
+		{
+#ifdef _WIN32
+			const int read_bytes = _read(fd, block.data(), READ_SIZE);
+#else
+			const ssize_t read_bytes = read(fd, block.data(), READ_SIZE);
+			if (read_bytes < 0 && errno == EINTR)
+				continue;
+#endif
 
-			if (this_name == docs)
+			if (read_bytes <= 0)
 			{
-				// Over-write the summary if a <docs> tag appears.
-				// This overrides the <summary> tag.
-				m.summary = summary_params_etc->value();
+				read_failed = read_bytes < 0;
+				break;
 			}
-			else if (this_name == param)
+
+			pending.append(block.data(), read_bytes);
+
+			if (!in_members)
 			{
-				// <param name="name_of_parameter">description</param>
+				const size_t members = pending.find("<members>");
+				if (members == std::string::npos)
+					continue;
 
-				// Add the name of the parameters.
-				m.function_parameters_name.push_back(summary_params_etc->first_attribute()->value());
+				offset += members + std::char_traits<char>::length("<members>");
+				pending.erase(0, members + std::char_traits<char>::length("<members>"));
+				in_members = true;
+			}
 
-				// Add the description of the parameters.
-				m.function_parameters_desc.push_back(summary_params_etc->value());
+			// Everything before </members> is the last chunk.
+			const size_t members_end = pending.find("</members>");
+			if (members_end != std::string::npos)
+			{
+				pending.resize(members_end);
+				Dispatch(pending.length());
+				members_closed = true;
+				break;
 			}
-			else if (this_name == returns_custom)
+
+			while (pending.length() > STREAM_CHUNK_SIZE + SLACK)
 			{
-				// <docreturns>custom return value</docreturns>
-				m.returns = summary_params_etc->value();
+				const char* last = pending.data() + pending.length() - SLACK;
+				const char* boundary = FindMember(pending.data() + STREAM_CHUNK_SIZE, last);
+
+				if (boundary == last)
+					break;
+
+				Dispatch(boundary - pending.data());
 			}
-			else if (this_name == returns_default)
+		}
+	};
+
+	const bool parsed = RunPipeline(source, Load, pipeline, parameters, parser, all_mw, error);
+
+	// What went wrong with the stream comes before what went wrong with the part of it that was read.
+	if (read_failed)
+	{
+		error = "Reading MW.xml from " + source + " failed after " + std::to_string(offset + pending.length()) + " bytes!";
+		return false;
+	}
+
+	if (!in_members)
+	{
+		MLOG(Warning, "The MW.xml read from " << source << " has no <members>!");
+		all_mw.clear();
+		return true;
+	}
+
+	if (!members_closed)
+	{
+		error = "The MW.xml read from " + source + " ends before </members>!";
+		return false;
+	}
+
+	if (!parsed)
+		return false;
+
+	MLOG(Verbose, "Read " << offset << " bytes of <members> from " << source << '.');
+
+	return true;
+}
+
+namespace
+{
+	/*
+	* A slice of <members> as it moves through the stages of Reader::RunPipeline.
+	*/
+	struct Chunk
+	{
+		size_t index;
+		size_t offset;
+
+		// What is parsed: a span of the mapped MW.xml, or of text. doc, or scanned, points
+		// into it until the chunk is processed.
+		std::string_view span;
+		// A terminated copy of the chunk, for rapidxml or when the chunk is not mapped.
+		std::string text;
+		std::unique_ptr<xml_document<>> doc;
+		std::vector<MemberXML> scanned;
+		std::string error;
+
+		std::vector<MW> mw;
+		ParameterStore parameters;
+	};
+}
+
+bool Reader::RunPipeline(const std::string& source, const std::function<void(const ChunkSink&)>& load, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser, std::vector<MW>& all_mw, std::string& error)
+{
+	BoundedQueue<std::unique_ptr<Chunk>> loaded(pipeline.queue_depth);
+	BoundedQueue<std::unique_ptr<Chunk>> parsed(pipeline.queue_depth);
+
+	std::mutex finished_mutex;
+	std::vector<std::unique_ptr<Chunk>> finished;
+
+	auto Parse = [&]()
+	{
+		std::unique_ptr<Chunk> chunk;
+
+		while (loaded.Pop(chunk))
+		{
+			if (parser == EParser::Scanner)
 			{
-				// <returns>return value</returns>
+				PhaseScope parse(EPhase::Parse);
+				chunk->error = SchemaScanner::Scan(chunk->span, chunk->offset, chunk->scanned);
 
-				if (m.returns.length() == 0)
-				{
-					m.returns = summary_params_etc->value();
-				}
+				parsed.Push(std::move(chunk));
+				continue;
 			}
-			else if (this_name == doc_remarks)
+
+			chunk->doc.reset(new xml_document<>());
+
+			try
 			{
-				// <docremarks>doc remarks</docremarks>
-				m.remarks = summary_params_etc->value();
+				PhaseScope parse(EPhase::Parse);
+				chunk->doc->parse<parse_non_destructive>(&chunk->text[0]);
 			}
-			else if (this_name == remarks)
+			catch (const parse_error& e)
 			{
-				// <remarks>remarks</remarks>
-				m.remarks = summary_params_etc->value();
+				chunk->error = std::string(e.what()) + " at byte " + std::to_string(chunk->offset + (e.where<char>() - chunk->text.data()));
+				chunk->doc.reset();
 			}
-			else if (this_name == decorations)
+
+			parsed.Push(std::move(chunk));
+		}
+	};
+
+	auto Process = [&]()
+	{
+		std::unique_ptr<Chunk> chunk;
+
+		while (parsed.Pop(chunk))
+		{
+			if (chunk->error.length() == 0)
 			{
-				// <decorations name="value"...></decorations>
+				PhaseScope process(EPhase::Process);
+
+				if (chunk->doc)
+				{
+					for (xml_node<>* member = chunk->doc->first_node(); member; member = member->next_sibling())
+					{
+						chunk->mw.push_back(ProcessMember(member, chunk->parameters));
+					}
+				}
+				else
+				{
+					for (MemberXML& member : chunk->scanned)
+					{
+						chunk->mw.push_back(BuildMember(member, chunk->parameters));
+					}
+				}
 
-				std::string ReplacedAngleBrackets = summary_params_etc->first_attribute()->value();
-				SwapChars::ReplaceAngleBrackets(ReplacedAngleBrackets, true);
-				m.decorations.push_back(ReplacedAngleBrackets);
+				// The MW hold copies of everything they need from the XML.
+				chunk->doc.reset();
+				std::vector<MemberXML>().swap(chunk->scanned);
+				chunk->span = std::string_view();
+				std::string().swap(chunk->text);
 			}
+
+			std::lock_guard<std::mutex> lock(finished_mutex);
+			finished.push_back(std::move(chunk));
+		}
+	};
+
+	std::vector<std::thread> parsers, processors;
+	for (unsigned t = 0; t < std::max(1u, pipeline.parse); ++t)
+	{
+		parsers.emplace_back(Parse);
+	}
+
+	for (unsigned t = 0; t < std::max(1u, pipeline.process); ++t)
+	{
+		processors.emplace_back(Process);
+	}
+
+	// Load on this thread, while the chunks before are parsed and processed.
+	size_t chunks = 0;
+	load([&](const std::string_view text, const bool mapped, const size_t offset)
+	{
+		std::unique_ptr<Chunk> chunk(new Chunk());
+		chunk->index = chunks++;
+		chunk->offset = offset;
+
+		// The scanner reads a mapped chunk in place. rapidxml only stops parsing at a '\0', so
+		// it is given a terminated copy.
+		if (mapped && parser == EParser::Scanner)
+		{
+			chunk->span = text;
+		}
+		else
+		{
+			chunk->text.assign(text.data(), text.length());
+			chunk->span = chunk->text;
 		}
 
-#if WRITE_NO_DECORATIONS
-		if (!m.decorations.size() && m.mw_type == MEMBER && m.mw_name != "CONSTRUCTOR")
+		loaded.Push(std::move(chunk));
+	});
+
+	loaded.Close();
+	for (auto& parser : parsers)
+	{
+		parser.join();
+	}
+
+	parsed.Close();
+	for (auto& processor : processors)
+	{
+		processor.join();
+	}
+
+	Pipeline::Record("load", "parse", std::max(1u, pipeline.parse), loaded.Stats());
+	Pipeline::Record("parse", "process", std::max(1u, pipeline.process), parsed.Stats());
+
+	MLOG(Verbose, "Parsed " << source << " in " << chunks << " chunks.");
+
+	// Chunks finish out of order.
+	std::sort(finished.begin(), finished.end(), [](const std::unique_ptr<Chunk>& a, const std::unique_ptr<Chunk>& b) { return a->index < b->index; });
+
+	std::vector<std::vector<MW>> chunk_mw;
+	std::vector<std::string> chunk_errors;
+
+	for (auto& chunk : finished)
+	{
+		chunk_mw.push_back(std::move(chunk->mw));
+		chunk_errors.push_back(std::move(chunk->error));
+	}
+
+	// The MW point into the ParameterStore of their chunk until Collect gathers them.
+	return Collect(source, chunk_mw, chunk_errors, parameters, all_mw, error);
+}
+
+bool Reader::Collect(const std::string& source, std::vector<std::vector<MW>>& chunk_mw, const std::vector<std::string>& chunk_errors, ParameterStore& parameters, std::vector<MW>& all_mw, std::string& error)
+{
+	for (auto& chunk_error : chunk_errors)
+	{
+		if (chunk_error.length() != 0)
 		{
-			std::cout << m.mw_namespace << '.' << m.mw_class << '.' << m.mw_name << " has no decorations!\n";
+			error = "The MW.xml file at: " + source + " could not be parsed: " + chunk_error;
+			return false;
 		}
-#endif // WRITE_NO_DECORATIONS
+	}
 
+	PhaseScope process(EPhase::Process);
+
+	// Concatenate in the original order so that the output is deterministic.
+	size_t total = 0;
+	for (auto& mw : chunk_mw)
+	{
+		total += mw.size();
+	}
+
+	all_mw.clear();
+	all_mw.reserve(total);
+
+	for (auto& mw : chunk_mw)
+	{
+		all_mw.insert(all_mw.end(), std::make_move_iterator(mw.begin()), std::make_move_iterator(mw.end()));
+	}
+
+	SortMembers(all_mw);
+
+	// Gather the parameters of every chunk into parameters, in the sorted order, so that
+	// a page's parameters are contiguous.
+	parameters.Gather(all_mw);
+
+	for (auto& m : all_mw)
+	{
 		m.Print();
+	}
+
+	return true;
+}
+
+void Reader::SortMembers(std::vector<MW>& all_mw)
+{
+	const size_t count = all_mw.size();
+
+	// Replace every string key with its rank among the distinct values of that key,
+	// so that each key can be counting sorted. Only the distinct values are compared.
+	auto Rank = [&all_mw, count](std::string MW::* field, uint32_t& ranks)
+	{
+		std::unordered_map<std::string, uint32_t> distinct;
+		for (auto& mw : all_mw)
+		{
+			distinct.emplace(mw.*field, 0);
+		}
+
+		std::vector<const std::string*> sorted;
+		sorted.reserve(distinct.size());
+		for (auto& value : distinct)
+		{
+			sorted.push_back(&value.first);
+		}
 
-		all_mw.push_back(m);
+		std::sort(sorted.begin(), sorted.end(), [](const std::string* l, const std::string* r) { return *l < *r; });
+
+		for (uint32_t r = 0; r < sorted.size(); ++r)
+		{
+			distinct[*sorted[r]] = r;
+		}
+
+		std::vector<uint32_t> keys(count);
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys[i] = distinct[all_mw[i].*field];
+		}
+
+		ranks = static_cast<uint32_t>(sorted.size());
+		return keys;
+	};
+
+	uint32_t namespaces, classes, names, arities = 0;
+	const std::vector<uint32_t> namespace_keys = Rank(&MW::mw_namespace, namespaces);
+	const std::vector<uint32_t> class_keys = Rank(&MW::mw_class, classes);
+	const std::vector<uint32_t> name_keys = Rank(&MW::mw_name, names);
+
+	std::vector<uint32_t> arity_keys(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		arity_keys[i] = all_mw[i].type_count;
+		arities = std::max(arities, arity_keys[i] + 1);
 	}
 
-#if WRITE_NO_DECORATIONS
-	std::cout << "Decoration checks complete!\n\n";
-#endif // WRITE_NO_DECORATIONS
+	// Least significant key first. Each pass is stable, so members with equal keys
+	// stay in the order they appear in MW.xml.
+	std::vector<uint32_t> order(count), sorted(count), buckets;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		order[i] = i;
+	}
 
-	delete doc;
+	auto CountingSort = [&](const std::vector<uint32_t>& keys, const uint32_t ranks)
+	{
+		buckets.assign(ranks + 1, 0);
 
-	return all_mw;
+		for (uint32_t i : order)
+		{
+			++buckets[keys[i] + 1];
+		}
+
+		for (uint32_t r = 1; r <= ranks; ++r)
+		{
+			buckets[r] += buckets[r - 1];
+		}
+
+		for (uint32_t i : order)
+		{
+			sorted[buckets[keys[i]]++] = i;
+		}
+
+		order.swap(sorted);
+	};
+
+	CountingSort(arity_keys, arities);
+	CountingSort(name_keys, names);
+	CountingSort(class_keys, classes);
+	CountingSort(namespace_keys, namespaces);
+
+	std::vector<MW> sorted_mw;
+	sorted_mw.reserve(count);
+
+	for (uint32_t i : order)
+	{
+		sorted_mw.push_back(std::move(all_mw[i]));
+	}
+
+	all_mw.swap(sorted_mw);
+}
+
+MW Reader::ProcessMember(xml_node<>* member, ParameterStore& parameters)
+{
+	// Reused by every member parsed on this thread.
+	thread_local MemberXML xml;
+	ReadMember(member, xml);
+
+	return BuildMember(xml, parameters);
+}
+
+void Reader::ReadMember(xml_node<>* member, MemberXML& xml)
+{
+	xml.Clear();
+
+	// Values are not terminated in a non-destructive parse. Always read them with their size.
+	xml_attribute<>* member_name_attribute = member->first_attribute("name");
+	xml.name = std::string_view(member_name_attribute->value(), member_name_attribute->value_size());
+
+	// Everything that appears in the docs has a summary, write it here.
+	xml.summary = ReadInline(member->first_node());
+
+	/*
+	* When using tags that override the normal XML tags, ensure the custom
+	  tag is checked before the normal tag. See MemberXML::Apply.
+	*/
+	for (xml_node<>* summary_params_etc = member->first_node(); summary_params_etc; summary_params_etc = summary_params_etc->next_sibling())
+	{
+		const ETag tag = TagTable::Classify(summary_params_etc->name(), summary_params_etc->name_size());
+
+		xml_attribute<>* first_attribute = summary_params_etc->first_attribute();
+		xml_attribute<>* cref = summary_params_etc->first_attribute("cref");
+
+		xml.Apply(tag,
+			MemberXML::NeedsText(tag) ? ReadInline(summary_params_etc) : std::string(),
+			first_attribute ? std::string_view(first_attribute->value(), first_attribute->value_size()) : std::string_view(),
+			cref ? std::string_view(cref->value(), cref->value_size()) : std::string_view());
+	}
 }
 
-MW Reader::ProcessNode(const std::string& chars)
+MW Reader::BuildMember(MemberXML& xml, ParameterStore& parameters)
+{
+	// Reused by every member built on this thread.
+	thread_local VT(std::string) types, names;
+	types.clear();
+	names.clear();
+
+	const std::string member_name(xml.name);
+
+	MW m = ProcessNode(member_name, types);
+	m.doc_id = member_name;
+
+	m.summary = std::move(xml.summary);
+	m.returns = std::move(xml.returns);
+	m.remarks = std::move(xml.remarks);
+
+	for (std::string_view decor : xml.decorations)
+	{
+		std::string ReplacedAngleBrackets(decor);
+		SwapChars::ReplaceAngleBrackets(ReplacedAngleBrackets, true);
+		m.decorations.push_back(ReplacedAngleBrackets);
+	}
+
+	m.see_also.assign(xml.see_also.begin(), xml.see_also.end());
+	names.assign(xml.param_names.begin(), xml.param_names.end());
+
+	parameters.Append(m, types, names, xml.param_descriptions);
+
+	return m;
+}
+
+const char* Reader::Find(const char* begin, const char* end, const char* token)
+{
+	const char* found = std::search(begin, end, token, token + std::char_traits<char>::length(token));
+
+	return found;
+}
+
+const char* Reader::FindMember(const char* from, const char* end)
+{
+	// Text and attribute values cannot hold a raw '<', so the first "<member" after from that
+	// is not "<members" always begins a top-level <member>.
+	for (const char* found = Find(from, end, "<member"); found != end; found = Find(found + 1, end, "<member"))
+	{
+		const char after = found + 7 < end ? found[7] : '\0';
+
+		if (after == '>' || after == '/' || std::isspace(static_cast<unsigned char>(after)))
+			return found;
+	}
+
+	return end;
+}
+
+MW Reader::ProcessNode(const std::string& chars, VT(std::string)& types)
 {
 	MW mw;
 
@@ -228,7 +901,7 @@ MW Reader::ProcessNode(const std::string& chars)
 								SwapChars::Replace(param);
 
 								// Add the type of the parameter after replacing illegals.
-								mw.function_parameters_type.push_back(param);
+								types.push_back(param);
 							}
 							// Otherwise, process the generic type *first*, then replace and continue as normal...
 							else
@@ -236,7 +909,7 @@ MW Reader::ProcessNode(const std::string& chars)
 								ProcessPredefinedGenericType(param);
 								SwapChars::Replace(param);
 
-								mw.function_parameters_type.push_back(param);
+								types.push_back(param);
 								is_predefined_generic_type = false;
 							}
 
@@ -402,6 +1075,88 @@ void Reader::ProcessPredefinedGenericType(std::string& param)
 		param.erase(param.begin() + index_of_angle_bracket + 1, param.begin() + index_of_dot + 1);
 }
 
+std::string Reader::ReadInline(xml_node<>* node, const bool plain)
+{
+	std::string text;
+
+	if (node)
+		ReadInline(node, text, plain);
+
+	return text;
+}
+
+void Reader::ReadInline(xml_node<>* node, std::string& text, const bool plain)
+{
+	// Unlike xml_node::value(), which only holds the text before the first child element,
+	// this walks every child so that <see>, <paramref>, etc. and the text after them are kept.
+	// If plain, inline elements are flattened to their text. Labels cannot hold inline elements.
+	for (xml_node<>* child = node->first_node(); child; child = child->next_sibling())
+	{
+		switch (child->type())
+		{
+		case node_data:
+		case node_cdata:
+			text.append(child->value(), child->value_size());
+			break;
+		case node_element:
+		{
+			const std::string name(child->name(), child->name_size());
+			xml_attribute<>* cref = child->first_attribute("cref");
+			xml_attribute<>* name_attribute = child->first_attribute("name");
+			xml_attribute<>* langword = child->first_attribute("langword");
+
+			if (plain)
+			{
+				if (xml_attribute<>* name_or_word = name == "see" ? langword : name_attribute)
+					text.append(name_or_word->value(), name_or_word->value_size());
+				else
+					ReadInline(child, text, true);
+			}
+			else if (name == "see" && cref)
+			{
+				// <see cref="..."/> or <see cref="...">label</see>
+				Inline::Append(text, EInline::See, AttributeValue(cref), ReadInline(child, true));
+			}
+			else if (name == "see" && langword)
+			{
+				// <see langword="null"/>
+				Inline::Append(text, EInline::LangWord, AttributeValue(langword));
+			}
+			else if (name == "seealso" && cref)
+			{
+				Inline::Append(text, EInline::SeeAlso, AttributeValue(cref), ReadInline(child, true));
+			}
+			else if (name == "paramref" && name_attribute)
+			{
+				Inline::Append(text, EInline::ParamRef, AttributeValue(name_attribute));
+			}
+			else if (name == "typeparamref" && name_attribute)
+			{
+				Inline::Append(text, EInline::TypeParamRef, AttributeValue(name_attribute));
+			}
+			else if (name == "c")
+			{
+				Inline::Append(text, EInline::Code, ReadInline(child, true));
+			}
+			else
+			{
+				// <para>, <code>, <list>, etc. Keep their text.
+				ReadInline(child, text);
+			}
+
+			break;
+		}
+		default:
+			break;
+		}
+	}
+}
+
+std::string Reader::AttributeValue(xml_attribute<>* attribute)
+{
+	return std::string(attribute->value(), attribute->value_size());
+}
+
 bool Reader::FileExists(const char* file_name)
 {
 	struct stat buffer;
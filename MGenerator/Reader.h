@@ -1,23 +1,109 @@
 #pragma once
 
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "MMacros.h"
+
 struct MW;
+struct MemberXML;
+struct PipelineConfig;
+class ParameterStore;
+
+namespace rapidxml
+{
+	template<class Ch> class xml_node;
+	template<class Ch> class xml_attribute;
+}
+
+/*
+* How the XML of each chunk of MW.xml is parsed. Both build the same MW.
+*/
+enum class EParser
+{
+	// SchemaScanner: reads the documentation schema directly, without a DOM. The default.
+	Scanner,
+	// rapidxml: builds a DOM, which is then walked member by member.
+	RapidXML
+};
 
 class Reader
 {
 
 public:
 
-	static std::vector<MW> OpenFile();
+	/*
+	* Parses every <member> in MW.xml through the load, parse and process stages of pipeline.
+	* input is a path, "-" for standard input or "fd:N" for an open file descriptor; an empty
+	  input is the MW.xml built next to MGenerator.
+	* A stream is parsed chunk by chunk as it arrives, while the rest is still being written.
+	* The MW are sorted by namespace, class, name and arity, so every page is a contiguous
+	  range and the overloads of a function are next to each other.
+	* The parameters of every MW are stored in parameters, which must outlive them.
+	*/
+	static std::vector<MW> OpenFile(const std::string& input, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser = EParser::Scanner);
+
+	/*
+	* Parses input as OpenFile does, but returns false, with why in error, where OpenFile would
+	  terminate: a missing, malformed or cut off MW.xml. For callers that outlive one bad build,
+	  such as BuildServer.
+	*/
+	static bool Read(const std::string& input, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser, std::vector<MW>& all_mw, std::string& error);
+
+	/*
+	* Reads input, which must be a file, runs times times with each parser and checks that both
+	  build the same MW. Reports the fastest time of each.
+	* Returns false if the parsers disagree.
+	*/
+	static bool BenchmarkParsers(const std::string& input, const PipelineConfig& pipeline, const unsigned runs);
+
+	/* The MW.xml used when there is no --input. */
+	static const char* DefaultPath();
 
 private:
 
-	static MW ProcessNode(const std::string& chars);
+	static bool OpenStream(const int fd, const std::string& source, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser, std::vector<MW>& all_mw, std::string& error);
+
+	/*
+	* Takes each chunk of complete <member>s, in order, and the byte offset it begins at.
+	  mapped if text stays valid until RunPipeline returns, so that it need not be copied.
+	*/
+	using ChunkSink = std::function<void(std::string_view text, const bool mapped, const size_t offset)>;
+
+	/*
+	* Calls load on this thread to cut MW.xml into chunks, while the chunks already loaded
+	  are parsed and then processed on the threads of their stages.
+	* Stages are connected by BoundedQueues, so a slow stage holds up the ones before it
+	  instead of letting chunks pile up.
+	*/
+	static bool RunPipeline(const std::string& source, const std::function<void(const ChunkSink&)>& load, const PipelineConfig& pipeline, ParameterStore& parameters, const EParser parser, std::vector<MW>& all_mw, std::string& error);
+	/* Concatenates, sorts and gathers the parsed chunks into all_mw. False, with the first error of a chunk in error, if one could not be parsed. */
+	static bool Collect(const std::string& source, std::vector<std::vector<MW>>& chunk_mw, const std::vector<std::string>& chunk_errors, ParameterStore& parameters, std::vector<MW>& all_mw, std::string& error);
+
+	/* Reads a <member> from the rapidxml DOM, and builds its MW. */
+	static MW ProcessMember(rapidxml::xml_node<char>* member, ParameterStore& parameters);
+	static void ReadMember(rapidxml::xml_node<char>* member, MemberXML& xml);
+	/* Builds the MW of a <member>, however it was parsed. Moves the text out of xml. */
+	static MW BuildMember(MemberXML& xml, ParameterStore& parameters);
+	/* The MW described by a <member name="...">. The types in its signature are appended to types. */
+	static MW ProcessNode(const std::string& chars, VT(std::string)& types);
 	static void ProcessPredefinedGenericType(std::string& param);
+	static void ReadInline(rapidxml::xml_node<char>* node, std::string& text, const bool plain = false);
+	static std::string ReadInline(rapidxml::xml_node<char>* node, const bool plain = false);
+
+	/* Stable radix sort of all_mw by namespace, class, name and then the number of parameters. */
+	static void SortMembers(std::vector<MW>& all_mw);
+
+	static std::string AttributeValue(rapidxml::xml_attribute<char>* attribute);
 
 	static bool FileExists(const char* file_name);
 
+	/* The first token in [begin, end), or end. */
+	static const char* Find(const char* begin, const char* end, const char* token);
+	/* The start of the first top-level <member> in [from, end), or end. */
+	static const char* FindMember(const char* from, const char* end);
+
 };
 
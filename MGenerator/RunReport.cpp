@@ -0,0 +1,42 @@
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#include "RunReport.h"
+#include "JSON.h"
+
+namespace
+{
+	std::mutex report_mutex;
+	std::map<std::string, std::string> sections;
+}
+
+void RunReport::Set(const std::string& section, const std::string& json)
+{
+	std::lock_guard<std::mutex> lock(report_mutex);
+	sections[section] = json;
+}
+
+bool RunReport::Write(const std::string& path)
+{
+	std::string json = "{";
+
+	{
+		std::lock_guard<std::mutex> lock(report_mutex);
+
+		for (auto& section : sections)
+		{
+			json += json.length() == 1 ? "\n" : ",\n";
+			JSON::AppendString(json, section.first);
+			json += ':';
+			json += section.second;
+		}
+	}
+
+	json += "\n}\n";
+
+	std::ofstream file(path, std::ios_base::binary);
+	file.write(json.data(), json.size());
+
+	return !file.fail();
+}
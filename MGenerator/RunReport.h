@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string>
+
+/*
+* A machine-readable summary of a run, written with --report <path>.
+* Each instrumented part of MGenerator adds its own JSON section.
+*/
+class RunReport
+{
+
+public:
+
+	/* Sets section to json, which must be a complete JSON value. Thread-safe. */
+	static void Set(const std::string& section, const std::string& json);
+
+	/* Writes every section to path as one JSON object. Returns false if path could not be written. */
+	static bool Write(const std::string& path);
+
+};
@@ -0,0 +1,493 @@
+#include <cstring>
+#include <string_view>
+
+#include "SchemaScanner.h"
+#include "Inline.h"
+
+namespace
+{
+	/* Where, and why, a scan stopped. */
+	struct ScanError
+	{
+		const char* what;
+		const char* where;
+	};
+
+	// The same character classes as rapidxml, so that both split the input the same way.
+	enum ECharClass : uint8_t
+	{
+		WHITESPACE = 1,
+		NAME_END = 2,
+		ATTRIBUTE_NAME_END = 4
+	};
+
+	struct CharClasses
+	{
+		uint8_t of[256];
+	};
+
+	constexpr CharClasses BuildCharClasses()
+	{
+		CharClasses classes = {};
+
+		for (const char c : { ' ', '\n', '\r', '\t' })
+			classes.of[static_cast<unsigned char>(c)] |= WHITESPACE | NAME_END | ATTRIBUTE_NAME_END;
+
+		for (const char c : { '/', '>', '?', '\0' })
+			classes.of[static_cast<unsigned char>(c)] |= NAME_END | ATTRIBUTE_NAME_END;
+
+		for (const char c : { '<', '=', '!' })
+			classes.of[static_cast<unsigned char>(c)] |= ATTRIBUTE_NAME_END;
+
+		return classes;
+	}
+
+	constexpr CharClasses CHAR_CLASSES = BuildCharClasses();
+
+	bool Is(const char c, const ECharClass char_class)
+	{
+		return (CHAR_CLASSES.of[static_cast<unsigned char>(c)] & char_class) != 0;
+	}
+
+	bool IsWhitespace(const char c) { return Is(c, WHITESPACE); }
+	bool IsNameEnd(const char c) { return Is(c, NAME_END); }
+	bool IsAttributeNameEnd(const char c) { return Is(c, ATTRIBUTE_NAME_END); }
+
+	/*
+	* The character at p, or '\0' at end. The input is not terminated, so end reads as the '\0'
+	  that rapidxml stops at; a '\0' in the input ends it, as it does for rapidxml.
+	*/
+	char At(const char* p, const char* end)
+	{
+		return p < end ? *p : '\0';
+	}
+
+	void SkipWhitespace(const char*& p, const char* end)
+	{
+		while (p < end && IsWhitespace(*p))
+		{
+			++p;
+		}
+	}
+
+	/* The first c in [p, end), or the '\0' or end that the input ends at before it. */
+	const char* Find(const char* p, const char* end, const char c)
+	{
+		const char* found = static_cast<const char*>(std::memchr(p, c, end - p));
+		if (!found)
+			found = end;
+
+		const char* terminator = static_cast<const char*>(std::memchr(p, '\0', found - p));
+		return terminator ? terminator : found;
+	}
+
+	/* The first token in [p, end). Throws if the input ends first. */
+	const char* FindToken(const char* p, const char* end, const std::string_view token)
+	{
+		const std::string_view rest(p, Find(p, end, '\0') - p);
+		const size_t found = rest.find(token);
+		if (found == std::string_view::npos)
+			throw ScanError{ "unexpected end of data", p + rest.length() };
+
+		return p + found;
+	}
+
+	bool StartsWith(const char* p, const char* end, const char* prefix, const size_t length)
+	{
+		return static_cast<size_t>(end - p) >= length && std::memcmp(p, prefix, length) == 0;
+	}
+}
+
+void MemberXML::Clear()
+{
+	name = std::string_view();
+	summary.clear();
+	returns.clear();
+	remarks.clear();
+	param_names.clear();
+	param_descriptions.clear();
+	decorations.clear();
+	see_also.clear();
+	custom_remarks = false;
+}
+
+namespace
+{
+	typedef std::string_view Attribute;
+
+	constexpr size_t Index(const ETag tag) { return static_cast<size_t>(tag); }
+
+	/* Every tag without a handler here is ignored. */
+	constexpr std::array<MemberXML::TagHandler, Index(ETag::Count)> BuildHandlers()
+	{
+		std::array<MemberXML::TagHandler, Index(ETag::Count)> handlers = {};
+
+		// Over-write the summary if a <docs> tag appears.
+		handlers[Index(ETag::Docs)] = { true, [](MemberXML& xml, std::string&& text, Attribute, Attribute) { xml.summary = std::move(text); } };
+
+		// <param name="name_of_parameter">description</param>
+		handlers[Index(ETag::Param)] = { true, [](MemberXML& xml, std::string&& text, Attribute name, Attribute)
+		{
+			xml.param_names.push_back(name);
+			xml.param_descriptions.push_back(std::move(text));
+		} };
+
+		// <docreturns>custom return value</docreturns>
+		handlers[Index(ETag::DocReturns)] = { true, [](MemberXML& xml, std::string&& text, Attribute, Attribute) { xml.returns = std::move(text); } };
+
+		// Only if there was no <docreturns> before it.
+		handlers[Index(ETag::Returns)] = { true, [](MemberXML& xml, std::string&& text, Attribute, Attribute)
+		{
+			if (xml.returns.length() == 0)
+				xml.returns = std::move(text);
+		} };
+
+		// <docremarks>doc remarks</docremarks>
+		handlers[Index(ETag::DocRemarks)] = { true, [](MemberXML& xml, std::string&& text, Attribute, Attribute)
+		{
+			xml.remarks = std::move(text);
+			xml.custom_remarks = true;
+		} };
+
+		// Only if there was no <docremarks> before it.
+		handlers[Index(ETag::Remarks)] = { true, [](MemberXML& xml, std::string&& text, Attribute, Attribute)
+		{
+			if (!xml.custom_remarks)
+				xml.remarks = std::move(text);
+		} };
+
+		// <decorations decor="value"></decorations>
+		handlers[Index(ETag::Decorations)] = { false, [](MemberXML& xml, std::string&&, Attribute decor, Attribute) { xml.decorations.push_back(decor); } };
+
+		// <seealso cref="M:MW.MArray`1.Push(`0)"/>
+		handlers[Index(ETag::SeeAlso)] = { false, [](MemberXML& xml, std::string&&, Attribute, Attribute cref)
+		{
+			if (cref.data())
+				xml.see_also.push_back(cref);
+		} };
+
+		return handlers;
+	}
+}
+
+const std::array<MemberXML::TagHandler, static_cast<size_t>(ETag::Count)> MemberXML::HANDLERS = BuildHandlers();
+
+/*
+* Calls on_text(begin, end) for every run of text and CDATA, and on_element(p), with p just
+  after the '<', for every child element in the contents at p. Moves p past the end tag.
+* Like rapidxml, text keeps its leading whitespace, but whitespace alone before a tag is
+  not text. Comments and processing instructions are skipped.
+*/
+template <typename OnText, typename OnElement>
+static void Contents(const char*& p, const char* end, OnText on_text, OnElement on_element)
+{
+	for (;;)
+	{
+		const char* contents_start = p;
+		SkipWhitespace(p, end);
+
+		const char c = At(p, end);
+		if (c == '<')
+		{
+			const char next = At(p + 1, end);
+			if (next == '/')
+				return;
+
+			if (StartsWith(p, end, "<![CDATA[", 9))
+			{
+				const char* cdata_end = FindToken(p + 9, end, "]]>");
+				on_text(p + 9, cdata_end);
+				p = cdata_end + 3;
+			}
+			else if (next != '!' && next != '?')
+			{
+				++p;
+				on_element(p);
+			}
+			else
+			{
+				// <!-- -->, <? ?> or <!DOCTYPE >. Nothing in them is read.
+				const char* markup = p;
+				p = next == '?' ? FindToken(markup, end, "?>") + 2
+					: StartsWith(markup, end, "<!--", 4) ? FindToken(markup + 4, end, "-->") + 3
+					: FindToken(markup, end, ">") + 1;
+			}
+		}
+		else if (c == '\0')
+		{
+			throw ScanError{ "unexpected end of data", p };
+		}
+		else
+		{
+			p = Find(p, end, '<');
+			on_text(contents_start, p);
+		}
+	}
+}
+
+std::string SchemaScanner::Scan(const std::string_view text, const size_t offset, VT(MemberXML)& members)
+{
+	const char* const end = text.data() + text.length();
+
+	try
+	{
+		const char* p = text.data();
+
+		for (;;)
+		{
+			SkipWhitespace(p, end);
+
+			const char c = At(p, end);
+			if (c == '\0')
+				break;
+
+			if (c != '<')
+				throw ScanError{ "expected <", p };
+
+			const char next = At(p + 1, end);
+			if (next == '!' || next == '?')
+			{
+				p = next == '?' ? FindToken(p, end, "?>") + 2
+					: StartsWith(p, end, "<!--", 4) ? FindToken(p + 4, end, "-->") + 3
+					: StartsWith(p, end, "<![CDATA[", 9) ? FindToken(p + 9, end, "]]>") + 3
+					: FindToken(p, end, ">") + 1;
+				continue;
+			}
+
+			++p;
+			members.emplace_back();
+			Member(p, end, members.back());
+		}
+	}
+	catch (const ScanError& e)
+	{
+		return std::string(e.what) + " at byte " + std::to_string(offset + (e.where - text.data()));
+	}
+
+	return "";
+}
+
+bool SchemaScanner::StartTag(const char*& p, const char* end, std::string_view& name, Attributes& attributes)
+{
+	const char* name_begin = p;
+	while (!IsNameEnd(At(p, end)))
+	{
+		++p;
+	}
+
+	if (p == name_begin)
+		throw ScanError{ "expected element name", p };
+
+	name = std::string_view(name_begin, p - name_begin);
+	SkipWhitespace(p, end);
+
+	while (!IsAttributeNameEnd(At(p, end)))
+	{
+		const char* attribute_begin = p;
+		while (!IsAttributeNameEnd(At(p, end)))
+		{
+			++p;
+		}
+
+		const std::string_view attribute(attribute_begin, p - attribute_begin);
+
+		SkipWhitespace(p, end);
+		if (At(p, end) != '=')
+			throw ScanError{ "expected =", p };
+
+		++p;
+		SkipWhitespace(p, end);
+
+		const char quote = At(p, end);
+		if (quote != '"' && quote != '\'')
+			throw ScanError{ "expected ' or \"", p };
+
+		const char* value_begin = ++p;
+		const char* value_end = Find(p, end, quote);
+		if (At(value_end, end) != quote)
+			throw ScanError{ "expected ' or \"", value_end };
+
+		const std::string_view value(value_begin, value_end - value_begin);
+		p = value_end + 1;
+
+		// Like first_attribute(name), only the first attribute of each name counts.
+		if (!attributes.first.data())
+			attributes.first = value;
+
+		if (attribute == "name" && !attributes.name.data())
+			attributes.name = value;
+		else if (attribute == "cref" && !attributes.cref.data())
+			attributes.cref = value;
+		else if (attribute == "langword" && !attributes.langword.data())
+			attributes.langword = value;
+
+		SkipWhitespace(p, end);
+	}
+
+	if (At(p, end) == '>')
+	{
+		++p;
+		return false;
+	}
+
+	if (At(p, end) == '/' && At(p + 1, end) == '>')
+	{
+		p += 2;
+		return true;
+	}
+
+	throw ScanError{ "expected >", p };
+}
+
+void SchemaScanner::EndTag(const char*& p, const char* end)
+{
+	// "</", the name, which is not checked against the start tag, and '>'.
+	p += 2;
+	while (!IsNameEnd(At(p, end)))
+	{
+		++p;
+	}
+
+	SkipWhitespace(p, end);
+	if (At(p, end) != '>')
+		throw ScanError{ "expected >", p };
+
+	++p;
+}
+
+void SchemaScanner::Member(const char*& p, const char* end, MemberXML& member)
+{
+	std::string_view name;
+	Attributes attributes;
+
+	if (StartTag(p, end, name, attributes))
+		return;
+
+	member.name = attributes.name;
+
+	// Like Reader::ProcessMember, the summary is the text of the first child, whatever it is.
+	bool first = true;
+
+	Contents(p, end,
+		[&](const char*, const char*) { first = false; },
+		[&](const char*& child)
+		{
+			std::string_view child_name;
+			Attributes child_attributes;
+			const bool empty = StartTag(child, end, child_name, child_attributes);
+			const ETag tag = TagTable::Classify(child_name);
+
+			const bool is_first = first;
+			first = false;
+
+			std::string text;
+
+			if (!empty && (is_first || MemberXML::NeedsText(tag)))
+				ReadInline(child, end, text, false);
+			else if (!empty)
+				SkipContents(child, end);
+
+			if (is_first)
+				member.summary = text;
+
+			member.Apply(tag, std::move(text), child_attributes.first, child_attributes.cref);
+		});
+
+	EndTag(p, end);
+}
+
+void SchemaScanner::ReadInline(const char*& p, const char* end, std::string& text, const bool plain)
+{
+	// The same as Reader::ReadInline over the DOM. If plain, inline elements are flattened to their text.
+	Contents(p, end,
+		[&](const char* text_begin, const char* text_end) { text.append(text_begin, text_end - text_begin); },
+		[&](const char*& child)
+		{
+			std::string_view name;
+			Attributes attributes;
+			const bool empty = StartTag(child, end, name, attributes);
+			const ETag tag = TagTable::Classify(name);
+
+			auto Label = [&]()
+			{
+				std::string label;
+				if (!empty)
+					ReadInline(child, end, label, true);
+
+				return label;
+			};
+
+			auto Skip = [&]()
+			{
+				if (!empty)
+					SkipContents(child, end);
+			};
+
+			if (plain)
+			{
+				const std::string_view word = tag == ETag::See ? attributes.langword : attributes.name;
+
+				if (word.data())
+				{
+					text.append(word);
+					Skip();
+				}
+				else if (!empty)
+				{
+					ReadInline(child, end, text, true);
+				}
+			}
+			else if (tag == ETag::See && attributes.cref.data())
+			{
+				// <see cref="..."/> or <see cref="...">label</see>
+				Inline::Append(text, EInline::See, std::string(attributes.cref), Label());
+			}
+			else if (tag == ETag::See && attributes.langword.data())
+			{
+				// <see langword="null"/>
+				Inline::Append(text, EInline::LangWord, std::string(attributes.langword));
+				Skip();
+			}
+			else if (tag == ETag::SeeAlso && attributes.cref.data())
+			{
+				Inline::Append(text, EInline::SeeAlso, std::string(attributes.cref), Label());
+			}
+			else if (tag == ETag::ParamRef && attributes.name.data())
+			{
+				Inline::Append(text, EInline::ParamRef, std::string(attributes.name));
+				Skip();
+			}
+			else if (tag == ETag::TypeParamRef && attributes.name.data())
+			{
+				Inline::Append(text, EInline::TypeParamRef, std::string(attributes.name));
+				Skip();
+			}
+			else if (tag == ETag::C)
+			{
+				Inline::Append(text, EInline::Code, Label());
+			}
+			else if (!empty)
+			{
+				// <para>, <code>, <list>, etc. Keep their text.
+				ReadInline(child, end, text, false);
+			}
+		});
+
+	EndTag(p, end);
+}
+
+void SchemaScanner::SkipContents(const char*& p, const char* end)
+{
+	Contents(p, end,
+		[](const char*, const char*) {},
+		[end](const char*& child)
+		{
+			std::string_view name;
+			Attributes attributes;
+
+			if (!StartTag(child, end, name, attributes))
+				SkipContents(child, end);
+		});
+
+	EndTag(p, end);
+}
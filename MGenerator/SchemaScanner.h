@@ -0,0 +1,276 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "MMacros.h"
+
+/*
+* Every element of the documentation schema that MGenerator reads.
+* To read another child element of <member>, such as <example>, add it here, name it in
+  TagNames::TAGS and give it a handler in MemberXML's handler table.
+*/
+enum class ETag : uint8_t
+{
+	// Any element that is not part of the schema. Its text is kept; its tags are not.
+	Other,
+	Member,
+	Summary,
+	Docs,
+	Param,
+	Returns,
+	DocReturns,
+	Remarks,
+	DocRemarks,
+	Decorations,
+	SeeAlso,
+	See,
+	ParamRef,
+	TypeParamRef,
+	C,
+
+	// The number of tags; not a tag.
+	Count
+};
+
+/*
+* The names of every ETag, and a perfect hash of them, built at compile time.
+*/
+namespace TagNames
+{
+	struct TagName
+	{
+		const char* name;
+		size_t length;
+		ETag tag;
+	};
+
+	inline constexpr TagName TAGS[] =
+	{
+		{ "c", 1, ETag::C },
+		{ "see", 3, ETag::See },
+		{ "docs", 4, ETag::Docs },
+		{ "param", 5, ETag::Param },
+		{ "member", 6, ETag::Member },
+		{ "summary", 7, ETag::Summary },
+		{ "returns", 7, ETag::Returns },
+		{ "remarks", 7, ETag::Remarks },
+		{ "seealso", 7, ETag::SeeAlso },
+		{ "paramref", 8, ETag::ParamRef },
+		{ "docreturns", 10, ETag::DocReturns },
+		{ "docremarks", 10, ETag::DocRemarks },
+		{ "decorations", 11, ETag::Decorations },
+		{ "typeparamref", 12, ETag::TypeParamRef }
+	};
+
+	inline constexpr size_t TAG_COUNT = sizeof(TAGS) / sizeof(TAGS[0]);
+
+	constexpr size_t MaxLength()
+	{
+		size_t longest = 0;
+		for (const TagName& tag : TAGS)
+		{
+			longest = tag.length > longest ? tag.length : longest;
+		}
+
+		return longest;
+	}
+
+	inline constexpr size_t MAX_LENGTH = MaxLength();
+
+	// A power of two, comfortably larger than TAG_COUNT so that a seed is found quickly.
+	inline constexpr size_t SLOTS = 64;
+
+	/* Mixes the length and the first, middle and last characters of a name of at least one character. */
+	constexpr size_t Slot(const char* name, const size_t length, const uint32_t seed)
+	{
+		uint32_t hash = seed ^ static_cast<uint32_t>(length);
+		hash = hash * 31 + static_cast<unsigned char>(name[0]);
+		hash = hash * 31 + static_cast<unsigned char>(name[length / 2]);
+		hash = hash * 31 + static_cast<unsigned char>(name[length - 1]);
+
+		return (hash ^ (hash >> 7)) & (SLOTS - 1);
+	}
+
+	struct PerfectHash
+	{
+		uint32_t seed;
+		// One more than the index in TAGS of the tag in each slot, or 0 if there is none.
+		uint8_t slots[SLOTS];
+	};
+
+	/* The first seed under which no two tags share a slot. */
+	constexpr PerfectHash BuildHash()
+	{
+		for (uint32_t seed = 0;; ++seed)
+		{
+			PerfectHash hash = { seed, {} };
+			bool collides = false;
+
+			for (size_t i = 0; i < TAG_COUNT && !collides; ++i)
+			{
+				uint8_t& slot = hash.slots[Slot(TAGS[i].name, TAGS[i].length, seed)];
+				collides = slot != 0;
+				slot = static_cast<uint8_t>(i + 1);
+			}
+
+			if (!collides)
+				return hash;
+		}
+	}
+
+	static_assert(TAG_COUNT < SLOTS / 2, "TagNames::SLOTS is too small for every tag.");
+
+	inline constexpr PerfectHash HASH = BuildHash();
+}
+
+/*
+* Matches element names to ETag with one probe of TagNames::HASH and one comparison.
+*/
+class TagTable
+{
+
+public:
+
+	static constexpr ETag Classify(const char* name, const size_t length)
+	{
+		if (length == 0 || length > TagNames::MAX_LENGTH)
+			return ETag::Other;
+
+		const uint8_t slot = TagNames::HASH.slots[TagNames::Slot(name, length, TagNames::HASH.seed)];
+		if (slot == 0)
+			return ETag::Other;
+
+		const TagNames::TagName& tag = TagNames::TAGS[slot - 1];
+		return tag.length == length && Equals(tag.name, name, length) ? tag.tag : ETag::Other;
+	}
+
+	static constexpr ETag Classify(std::string_view name) { return Classify(name.data(), name.length()); }
+
+private:
+
+	static constexpr bool Equals(const char* a, const char* b, const size_t length)
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			if (a[i] != b[i])
+				return false;
+		}
+
+		return true;
+	}
+
+};
+
+static_assert(TagTable::Classify("docreturns", 10) == ETag::DocReturns && TagTable::Classify("member", 6) == ETag::Member
+	&& TagTable::Classify("example", 7) == ETag::Other, "TagTable is built at compile time.");
+
+/*
+* The parts of a <member> that Reader builds an MW from, however the XML was parsed.
+* Spans point into the XML, which must outlive this.
+*/
+struct MemberXML
+{
+	// The name attribute; the documentation ID. E.g., M:MW.MArray`1.Push(`0).
+	std::string_view name;
+
+	// Text, with inline elements encoded as in Inline.h.
+	std::string summary;
+	std::string returns;
+	std::string remarks;
+
+	VT(std::string_view) param_names;
+	VT(std::string) param_descriptions;
+
+	VT(std::string_view) decorations;
+	VT(std::string_view) see_also;
+
+	// Whether remarks came from a <docremarks>, so that a later <remarks> does not replace them.
+	bool custom_remarks = false;
+
+	void Clear();
+
+	/*
+	* What is done with a child element of <member>: its text, first attribute and cref attribute.
+	* An absent cref has a nullptr data(), so that it differs from cref="".
+	*/
+	typedef void (*Handler)(MemberXML& xml, std::string&& text, std::string_view first_attribute, std::string_view cref);
+
+	struct TagHandler
+	{
+		// Whether handle uses the text of the element, so that it is only read when needed.
+		bool needs_text;
+		// nullptr if the element is ignored.
+		Handler handle;
+	};
+
+	/* The handler of every ETag, indexed by the tag. See SchemaScanner.cpp. */
+	static const std::array<TagHandler, static_cast<size_t>(ETag::Count)> HANDLERS;
+
+	/* Whether Apply uses the text of an element with tag. */
+	static bool NeedsText(const ETag tag) { return HANDLERS[static_cast<size_t>(tag)].needs_text; }
+
+	/*
+	* Applies a child element of <member> with its handler.
+	* Custom tags take precedence over the standard tags they replace, in either order: <docs>
+	  over the summary, <docreturns> over <returns> and <docremarks> over <remarks>.
+	*/
+	void Apply(const ETag tag, std::string&& text, std::string_view first_attribute, std::string_view cref)
+	{
+		const TagHandler& handler = HANDLERS[static_cast<size_t>(tag)];
+		if (handler.handle)
+			handler.handle(*this, std::move(text), first_attribute, cref);
+	}
+};
+
+/*
+* A parser for the documentation XML of MW.xml that reads <member>s straight into MemberXML.
+* No DOM is built: tag names are matched with TagTable, attribute values and text are read
+  as spans of the input and elements outside of the schema are skipped over.
+* Like a non-destructive rapidxml parse, the input is not modified and entities are not
+  decoded, so Reader builds the same MW from either.
+* The input is a span, and need not be terminated, so Reader scans the chunks of a mapped
+  MW.xml where they are, without copying them.
+*/
+class SchemaScanner
+{
+
+public:
+
+	/*
+	* Scans every top-level element of text into members. Spans in members point into text.
+	* Returns an error, at a byte offset counted from offset, if text is not well-formed.
+	*/
+	static std::string Scan(const std::string_view text, const size_t offset, VT(MemberXML)& members);
+
+private:
+
+	struct Attributes
+	{
+		std::string_view first;
+		std::string_view name;
+		std::string_view cref;
+		std::string_view langword;
+	};
+
+	// Every function reads from p up to end, the end of the text being scanned.
+
+	/* Reads the name and attributes of the start tag at p, after its '<'. Returns true if the element is empty: <.../>. */
+	static bool StartTag(const char*& p, const char* end, std::string_view& name, Attributes& attributes);
+
+	/* Moves p past the end tag at p. */
+	static void EndTag(const char*& p, const char* end);
+
+	static void Member(const char*& p, const char* end, MemberXML& member);
+
+	/* Appends the text of the element whose contents begin at p to text, and moves p past its end tag. */
+	static void ReadInline(const char*& p, const char* end, std::string& text, const bool plain);
+
+	/* Moves p past the end tag of the element whose contents begin at p. */
+	static void SkipContents(const char*& p, const char* end);
+
+};
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+
+#include "Shard.h"
+#include "Hash.h"
+#include "Log.h"
+#include "Manifest.h"
+#include "Writer.h"
+
+bool Shard::Parse(const std::string& text, Shard& shard)
+{
+	char* slash;
+	const unsigned long i = std::strtoul(text.c_str(), &slash, 10);
+	if (*slash != '/')
+		return false;
+
+	char* end;
+	const unsigned long n = std::strtoul(slash + 1, &end, 10);
+	if (*end != '\0' || i < 1 || i > n)
+		return false;
+
+	shard.index = static_cast<unsigned>(i - 1);
+	shard.count = static_cast<unsigned>(n);
+	return true;
+}
+
+VT(unsigned) Shard::Assign(const Site& site, const unsigned count)
+{
+	const VT(Page)& pages = site.pages;
+
+	VT(size_t) order(pages.size());
+	VT(uint64_t) hashes(pages.size());
+	for (size_t p = 0; p < pages.size(); ++p)
+	{
+		order[p] = p;
+		hashes[p] = Hash::Of(pages[p].name);
+	}
+
+	auto Members = [&](const size_t p) { return static_cast<size_t>(pages[p].last - pages[p].first); };
+
+	std::sort(order.begin(), order.end(), [&](const size_t l, const size_t r)
+	{
+		if (Members(l) != Members(r))
+			return Members(l) > Members(r);
+		if (hashes[l] != hashes[r])
+			return hashes[l] < hashes[r];
+		return pages[l].name < pages[r].name;
+	});
+
+	VT(unsigned) shards(pages.size());
+	VT(size_t) loads(std::max(1u, count), 0);
+
+	for (size_t p : order)
+	{
+		// The first of the least loaded shards, so that ties always go the same way.
+		const unsigned least = static_cast<unsigned>(std::min_element(loads.begin(), loads.end()) - loads.begin());
+
+		shards[p] = least;
+		loads[least] += Members(p);
+	}
+
+	return shards;
+}
+
+std::string Shard::FragmentName() const
+{
+	return "manifest.shard-" + std::to_string(index + 1) + "-of-" + std::to_string(count) + ".json";
+}
+
+bool Shard::Merge(const std::string& directory, const char* name)
+{
+	VT(Shard) found;
+
+	std::error_code error;
+	for (auto& entry : std::filesystem::directory_iterator(directory, error))
+	{
+		// manifest.shard-2-of-4.json
+		const std::string file = entry.path().filename().string();
+		if (file.compare(0, 15, "manifest.shard-") != 0 || file.length() < 20 || file.compare(file.length() - 5, 5, ".json") != 0)
+			continue;
+
+		std::string shard = file.substr(15, file.length() - 20);
+		const size_t of = shard.find("-of-");
+		if (of == std::string::npos)
+			continue;
+
+		shard.replace(of, 4, "/");
+
+		Shard parsed;
+		if (Parse(shard, parsed))
+			found.push_back(parsed);
+	}
+
+	if (found.empty())
+	{
+		MLOG(Error, name << ": there are no manifest fragments in " << directory << " to merge.");
+		return false;
+	}
+
+	std::sort(found.begin(), found.end(), [](const Shard& l, const Shard& r) { return l.count != r.count ? l.count < r.count : l.index < r.index; });
+
+	// Exactly one fragment of every shard of one run.
+	const unsigned count = found.front().count;
+	bool complete = found.size() == count;
+	for (size_t i = 0; complete && i < found.size(); ++i)
+	{
+		complete = found[i].count == count && found[i].index == i;
+	}
+
+	if (!complete)
+	{
+		MLOG(Error, name << ": the manifest fragments in " << directory << " are not of every shard of one run. Expected 1 to " << count << " of " << count << '.');
+		return false;
+	}
+
+	VT(std::string) fragments;
+	for (const Shard& shard : found)
+	{
+		fragments.push_back(shard.FragmentName());
+	}
+
+	if (!Manifest::Merge(directory, fragments, name))
+		return false;
+
+	// The directory is now as a single run would have left it.
+	for (const std::string& fragment : fragments)
+	{
+		std::filesystem::remove(directory + fragment, error);
+	}
+
+	MLOG(Info, name << ": merged " << count << " manifest fragments.");
+
+	return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MMacros.h"
+
+struct Site;
+
+/*
+* One of count machines that each write part of the documentation, given by --shard i/N.
+*
+* Every shard reads the whole MW.xml, so navigation and cross-references are the same on
+  every page as in a single run. Pages are assigned to shards by Assign, which every shard
+  computes for itself from the same MW.xml, so no shard needs to know about the others.
+* Each shard writes its pages and a fragment of every manifest. Once the pages of every
+  shard are in one directory, merge combines the fragments into the manifest a single run
+  would have written.
+*/
+struct Shard
+{
+	// From 0, unlike --shard.
+	unsigned index = 0;
+	unsigned count = 1;
+
+	bool IsWhole() const { return count == 1; }
+
+	/* Parses i/N, where i is from 1 to N. E.g., 2/4. False if text is not a shard. */
+	static bool Parse(const std::string& text, Shard& shard);
+
+	/*
+	* The shard of every page of site, balanced by the number of members on each page.
+	* The largest pages are assigned first, each to the least loaded shard. Pages of the
+	  same size are ordered by a stable hash of their name, so the assignment only depends
+	  on MW.xml.
+	*/
+	static VT(unsigned) Assign(const Site& site, const unsigned count);
+
+	/* The manifest fragment this shard writes. E.g., manifest.shard-2-of-4.json. */
+	std::string FragmentName() const;
+
+	/*
+	* Merges the manifest fragments of every shard in directory into its manifest, then
+	  removes them. False if a shard's fragment is missing, or could not be merged.
+	*/
+	static bool Merge(const std::string& directory, const char* name);
+
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <string>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <afunix.h>
+#pragma comment(lib, "Ws2_32.lib")
+typedef SOCKET socket_t;
+#define CloseSocket closesocket
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+typedef int socket_t;
+#define INVALID_SOCKET -1
+#define CloseSocket close
+#endif
+
+// A peer that disconnects early must not raise SIGPIPE.
+#ifdef MSG_NOSIGNAL
+#define SEND_FLAGS MSG_NOSIGNAL
+#else
+#define SEND_FLAGS 0
+#endif
+
+/*
+* The few socket calls shared by PreviewServer and BuildServer, on Winsock and POSIX.
+*/
+class Socket
+{
+
+public:
+
+	/* Starts Winsock once. Always true elsewhere. */
+	static bool Start()
+	{
+#ifdef _WIN32
+		static const bool started = []()
+		{
+			WSADATA wsa;
+			return WSAStartup(MAKEWORD(2, 2), &wsa) == 0;
+		}();
+
+		return started;
+#else
+		return true;
+#endif
+	}
+
+	/* Sends all of data. False if the peer went away first. */
+	static bool SendAll(socket_t socket, const std::string& data)
+	{
+		for (size_t sent = 0; sent < data.length();)
+		{
+			const int wrote = static_cast<int>(send(socket, data.data() + sent, static_cast<int>(data.length() - sent), SEND_FLAGS));
+			if (wrote <= 0)
+				return false;
+
+			sent += wrote;
+		}
+
+		return true;
+	}
+
+	/* Makes every recv on socket fail once it has waited milliseconds for data. */
+	static bool SetReceiveTimeout(socket_t socket, const unsigned milliseconds)
+	{
+#ifdef _WIN32
+		const DWORD timeout = milliseconds;
+#else
+		timeval timeout;
+		timeout.tv_sec = milliseconds / 1000;
+		timeout.tv_usec = (milliseconds % 1000) * 1000;
+#endif
+
+		return setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout)) == 0;
+	}
+
+	/* Receives into data until the peer closes its end. */
+	static void ReceiveAll(socket_t socket, std::string& data)
+	{
+		char buffer[4096];
+
+		for (;;)
+		{
+			const int received = static_cast<int>(recv(socket, buffer, sizeof(buffer), 0));
+			if (received <= 0)
+				return;
+
+			data.append(buffer, received);
+		}
+	}
+
+	/* Fills address with the UNIX domain socket at path. False if path is too long. */
+	static bool UnixAddress(const std::string& path, sockaddr_un& address)
+	{
+		address = {};
+		address.sun_family = AF_UNIX;
+
+		if (path.length() >= sizeof(address.sun_path))
+			return false;
+
+		path.copy(address.sun_path, path.length());
+		return true;
+	}
+
+};
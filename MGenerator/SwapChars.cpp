@@ -1,7 +1,64 @@
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
 #include "SwapChars.h"
+#include "Log.h"
+#include "RunReport.h"
 
+SwapChars::CacheShard SwapChars::cache[SwapChars::SHARDS];
+std::atomic<size_t> SwapChars::cached{ 0 };
+std::atomic<uint64_t> SwapChars::hits{ 0 };
+std::atomic<uint64_t> SwapChars::misses{ 0 };
 
 void SwapChars::Replace(std::string& param, const bool is_file_name, const bool treat_as_template)
+{
+	CacheShard& shard = cache[std::hash<std::string>()(param) % SHARDS];
+	std::unordered_map<std::string, std::string>& translated = shard.translated[(is_file_name ? 1 : 0) | (treat_as_template ? 2 : 0)];
+
+	{
+		std::shared_lock<std::shared_mutex> lock(shard.mutex);
+
+		auto found = translated.find(param);
+		if (found != translated.end())
+		{
+			hits.fetch_add(1, std::memory_order_relaxed);
+			param = found->second;
+			return;
+		}
+	}
+
+	misses.fetch_add(1, std::memory_order_relaxed);
+
+	// Past MAX_CACHED, param is translated without being cached.
+	if (cached.load(std::memory_order_relaxed) >= MAX_CACHED)
+	{
+		Swap(param, is_file_name, treat_as_template);
+		return;
+	}
+
+	std::string raw = param;
+	Swap(param, is_file_name, treat_as_template);
+
+	std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+	// Another thread may have translated raw in the meantime; either result is the same.
+	if (translated.emplace(std::move(raw), param).second)
+		cached.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SwapChars::Report()
+{
+	const uint64_t hit = hits.load(), miss = misses.load();
+	const double hit_rate = hit + miss != 0 ? 100.0 * hit / (hit + miss) : 0;
+
+	MLOG(Info, "SwapChars: " << hit + miss << " translations, " << static_cast<int>(hit_rate + 0.5) << "% cached, " << cached.load() << " distinct.");
+
+	RunReport::Set("swapchars", "{\"translations\":" + std::to_string(hit + miss) + ",\"hits\":" + std::to_string(hit)
+		+ ",\"hit_rate\":" + std::to_string(hit_rate / 100) + ",\"cached\":" + std::to_string(cached.load()) + '}');
+}
+
+void SwapChars::Swap(std::string& param, const bool is_file_name, const bool treat_as_template)
 {
 	if (!treat_as_template)
 	{
@@ -11,7 +68,7 @@ void SwapChars::Replace(std::string& param, const bool is_file_name, const bool
 	// Hard-coded replacements.
 	if (translator.count(param))
 	{
-		param = translator[param];
+		param = translator.at(param);
 	}
 	else
 	{
@@ -20,7 +77,7 @@ void SwapChars::Replace(std::string& param, const bool is_file_name, const bool
 			// This is an overloaded operator.
 			if (param.length() > 3 && param[2] == '_' && translator.count(param))
 			{
-				param = translator[param];
+				param = translator.at(param);
 			}
 			else
 			{
@@ -117,6 +174,10 @@ std::map<std::string, std::string> SwapChars::translator;
 
 void SwapChars::BuildTranslator()
 {
+	// Only built once per process, however many times MW.xml is read.
+	if (!translator.empty())
+		return;
+
 	translator["Single"] = "float";
 	translator["Boolean"] = "bool";
 	translator["Int32"] = "int";
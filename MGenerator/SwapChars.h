@@ -1,20 +1,55 @@
 #pragma once
 
-#include <string>
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
 
 class SwapChars
 {
 
 public:
 
+	/*
+	* Translates param in place. Thread-safe.
+	* A few hundred strings, such as System.Single, ``0 and MW.FVector@, are nearly every
+	  call, so translations are cached: only the first call with the same param and flags
+	  does the work.
+	*/
 	static void Replace(std::string& param, const bool is_file_name = false, const bool treat_as_template = false);
 	static void ReplaceAngleBrackets(std::string& param, const bool continuous = false);
 	static void BuildTranslator();
 
+	/* Logs the hit rate of Replace and adds a "swapchars" section to the RunReport. */
+	static void Report();
+
 private:
 
+	/* The uncached translation of param. */
+	static void Swap(std::string& param, const bool is_file_name, const bool treat_as_template);
+
 	static std::map<std::string, std::string> translator;
 
-};
+	// Translations are spread over shards, by hash, so that parsing threads rarely wait on
+	// each other. Each shard has one map for every combination of flags.
+	static constexpr size_t SHARDS = 16;
 
+	struct CacheShard
+	{
+		std::shared_mutex mutex;
+		std::unordered_map<std::string, std::string> translated[4];
+	};
+
+	static CacheShard cache[SHARDS];
+
+	// Past this many translations, such as when every member name is distinct, a miss is
+	// translated without being cached.
+	static constexpr size_t MAX_CACHED = 1 << 16;
+
+	static std::atomic<size_t> cached;
+	static std::atomic<uint64_t> hits;
+	static std::atomic<uint64_t> misses;
+
+};
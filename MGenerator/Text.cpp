@@ -0,0 +1,161 @@
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+#include "Text.h"
+
+void Text::AppendHTML(std::string& html, const char* raw, const size_t length)
+{
+	html.reserve(html.length() + length);
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		const char c = raw[i];
+
+		switch (c)
+		{
+		case '&':
+		{
+			unsigned long decoded;
+			const size_t entity_length = ParseEntity(raw + i, length - i, decoded);
+
+			if (entity_length != 0)
+			{
+				html.append(raw + i, entity_length);
+				i += entity_length - 1;
+			}
+			else
+			{
+				html += "&amp;";
+			}
+
+			break;
+		}
+		case '<':
+			html += "&lt;";
+			break;
+		case '>':
+			html += "&gt;";
+			break;
+		case '"':
+			html += "&quot;";
+			break;
+		default:
+			html += c;
+			break;
+		}
+	}
+}
+
+std::string Text::HTML(const std::string& raw)
+{
+	std::string html;
+	AppendHTML(html, raw.data(), raw.length());
+
+	return html;
+}
+
+void Text::AppendDecoded(std::string& text, const char* raw, const size_t length)
+{
+	text.reserve(text.length() + length);
+
+	for (size_t i = 0; i < length; ++i)
+	{
+		unsigned long decoded;
+		const size_t entity_length = raw[i] == '&' ? ParseEntity(raw + i, length - i, decoded) : 0;
+
+		if (entity_length != 0)
+		{
+			AppendUTF8(text, decoded);
+			i += entity_length - 1;
+		}
+		else
+		{
+			text += raw[i];
+		}
+	}
+}
+
+std::string Text::Decoded(const std::string& raw)
+{
+	std::string text;
+	AppendDecoded(text, raw.data(), raw.length());
+
+	return text;
+}
+
+size_t Text::ParseEntity(const char* raw, const size_t length, unsigned long& decoded)
+{
+	// The longest entity MW.xml can hold is &#x10FFFF;.
+	const size_t max_length = length < 10 ? length : 10;
+
+	const char* semicolon = static_cast<const char*>(std::memchr(raw, ';', max_length));
+	if (!semicolon)
+		return 0;
+
+	const size_t entity_length = semicolon - raw + 1;
+
+	if (raw[1] == '#')
+	{
+		const bool hex = raw[2] == 'x' || raw[2] == 'X';
+		const char* digits = raw + (hex ? 3 : 2);
+
+		if (digits == semicolon)
+			return 0;
+
+		// strtoul would also take whitespace and a sign, which XML does not.
+		for (const char* digit = digits; digit != semicolon; ++digit)
+		{
+			if (!(hex ? std::isxdigit(static_cast<unsigned char>(*digit)) : std::isdigit(static_cast<unsigned char>(*digit))))
+				return 0;
+		}
+
+		decoded = std::strtoul(digits, nullptr, hex ? 16 : 10);
+
+		// Surrogates are not characters, and have no UTF-8.
+		const bool surrogate = decoded >= 0xD800 && decoded <= 0xDFFF;
+
+		return decoded != 0 && decoded <= 0x10FFFF && !surrogate ? entity_length : 0;
+	}
+
+	const struct { const char* name; char c; } named[] = {
+		{ "&lt;", '<' }, { "&gt;", '>' }, { "&amp;", '&' }, { "&quot;", '"' }, { "&apos;", '\'' }
+	};
+
+	for (auto& entity : named)
+	{
+		if (std::strlen(entity.name) == entity_length && std::memcmp(raw, entity.name, entity_length) == 0)
+		{
+			decoded = static_cast<unsigned char>(entity.c);
+			return entity_length;
+		}
+	}
+
+	return 0;
+}
+
+void Text::AppendUTF8(std::string& text, const unsigned long code_point)
+{
+	if (code_point < 0x80)
+	{
+		text += static_cast<char>(code_point);
+	}
+	else if (code_point < 0x800)
+	{
+		text += static_cast<char>(0xC0 | (code_point >> 6));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+	else if (code_point < 0x10000)
+	{
+		text += static_cast<char>(0xE0 | (code_point >> 12));
+		text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+	else
+	{
+		text += static_cast<char>(0xF0 | (code_point >> 18));
+		text += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+		text += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		text += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+
+/*
+* Text read from MW.xml is kept exactly as it is written in the file, with its
+  entities (&lt;, &amp;, &#169;, ...) untranslated.
+* Entities are only decoded when the text is rendered, by the Writer that renders it.
+*/
+class Text
+{
+
+public:
+
+	/*
+	* Appends raw to html, escaped for HTML.
+	* Entities are already valid HTML, so they are written as-is instead of being decoded
+	  and escaped again. Characters that are special in HTML are escaped.
+	*/
+	static void AppendHTML(std::string& html, const char* raw, const size_t length);
+	static std::string HTML(const std::string& raw);
+
+	/* Appends raw to text with every entity decoded. Numeric entities are written as UTF-8. */
+	static void AppendDecoded(std::string& text, const char* raw, const size_t length);
+	static std::string Decoded(const std::string& raw);
+
+private:
+
+	/*
+	* The length of the entity at raw[0], including the '&' and ';', or 0 if raw
+	  does not begin with a well-formed entity.
+	* If it is well-formed, decoded is the code point of the entity.
+	*/
+	static size_t ParseEntity(const char* raw, const size_t length, unsigned long& decoded);
+
+	static void AppendUTF8(std::string& text, const unsigned long code_point);
+
+};
@@ -1,9 +1,10 @@
 
 #if WITH_TIMER
-#include <iostream>
 #include <string>
 #include <chrono>
 
+#include "Log.h"
+
 struct PerformanceTimer
 {
 	
@@ -30,11 +31,11 @@ inline void PerformanceTimer::PrintTime(const std::string& message)
 {
 	if (message == "")
 	{
-		std::cout << std::chrono::duration_cast<std::chrono::milliseconds>(Now()).count() << "ms.\n";
+		MLOG(Info, std::chrono::duration_cast<std::chrono::milliseconds>(Now()).count() << "ms.");
 	}
 	else
 	{
-		std::cout << message << " " << std::chrono::duration_cast<std::chrono::milliseconds>(Now()).count() << "ms.\n";
+		MLOG(Info, message << " " << std::chrono::duration_cast<std::chrono::milliseconds>(Now()).count() << "ms.");
 	}
 }
 
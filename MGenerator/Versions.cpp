@@ -0,0 +1,322 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+#include "Versions.h"
+#include "ApiDiff.h"
+#include "CrossReference.h"
+#include "JSON.h"
+#include "Log.h"
+#include "Options.h"
+#include "OutputSink.h"
+#include "PageStore.h"
+#include "ParameterStore.h"
+#include "Reader.h"
+#include "RunReport.h"
+#include "Writer.h"
+
+namespace
+{
+	/* The Docs directory, relative to the working directory, as every Writer's OutputPath. */
+	std::string DocsPath()
+	{
+#if EXEC_FROM_VS
+		return "../Docs/";
+#else
+		return "../../Docs/";
+#endif
+	}
+
+	/* The directory of backend in a version's tree. E.g., HTML/ for ../../Docs/HTML/. */
+	std::string TreePath(const Writer& backend)
+	{
+		const std::string docs = DocsPath();
+		const std::string output_path = backend.OutputPath();
+
+		if (output_path.compare(0, docs.length(), docs) == 0)
+			return output_path.substr(docs.length());
+
+		return std::string(backend.Name()) + '/';
+	}
+
+	bool ReadFile(const std::string& path, std::string& content)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return false;
+
+		std::ostringstream read;
+		read << file.rdbuf();
+		content = read.str();
+		return true;
+	}
+}
+
+bool Versions::Parse(const std::string& list, VT(VersionInput)& versions)
+{
+	VT(VersionInput) parsed;
+
+	// E.g., 1.0=old/MW.xml,1.1=MW.xml.
+	for (size_t begin = 0; begin <= list.length();)
+	{
+		size_t end = list.find(',', begin);
+		if (end == std::string::npos)
+			end = list.length();
+
+		const std::string version = list.substr(begin, end - begin);
+		const size_t equals = version.find('=');
+		if (equals == std::string::npos || equals == 0 || equals + 1 == version.length())
+			return false;
+
+		VersionInput input = { version.substr(0, equals), version.substr(equals + 1) };
+
+		// Every name is a directory next to the store.
+		if (input.name == "Store" || input.name == "." || input.name == ".." || input.name.find_first_of("/\\:") != std::string::npos)
+			return false;
+
+		for (const VersionInput& other : parsed)
+		{
+			if (other.name == input.name)
+				return false;
+		}
+
+		parsed.push_back(std::move(input));
+		begin = end + 1;
+	}
+
+	versions = parsed;
+	return true;
+}
+
+bool Versions::Generate(const VT(VersionInput)& versions, const VT(Writer*)& backends, const Options& options)
+{
+	using Clock = std::chrono::steady_clock;
+
+	// Reader terminates on a missing file, so every input is checked before anything is written.
+	std::error_code error;
+	for (const VersionInput& version : versions)
+	{
+		if (!std::filesystem::is_regular_file(version.input, error))
+		{
+			MLOG(Error, "The MW.xml of version " << version.name << " at: " << version.input << " cannot be found, or opened!");
+			return false;
+		}
+	}
+
+	const std::string root = DocsPath() + "Versions/";
+	PageStore store(root + "Store/");
+
+	// The previous version's parse, and the address of each of its pages by backend and page name.
+	std::unique_ptr<ParameterStore> previous_parameters(new ParameterStore);
+	VT(MW) previous_mw;
+	std::vector<std::map<std::string, std::string>> previous(backends.size());
+
+	std::string mapping = "{\n\"store\":\"Store/\",\n\"versions\":[";
+	std::string report = "{\"versions\":[";
+	bool failed = false;
+
+	for (size_t v = 0; v < versions.size(); ++v)
+	{
+		const VersionInput& version = versions[v];
+		const Clock::time_point start = Clock::now();
+
+		std::unique_ptr<ParameterStore> parameters(new ParameterStore);
+		VT(MW) all_mw = Reader::OpenFile(version.input, options.Stages(), *parameters, options.parser);
+
+		// The first version has nothing before it, so every member is added.
+		const ApiChanges changes = ApiDiff::Compute(previous_mw, all_mw);
+		const bool restructured = !changes.added.empty() || !changes.removed.empty();
+
+		std::unordered_set<std::string> dirty;
+		for (const ApiChange& change : changes.changed)
+		{
+			dirty.insert(change.after->mw_namespace);
+		}
+
+		CrossReference crefs;
+		crefs.Build(all_mw);
+		const Site site = Writer::Paginate(all_mw);
+
+		// The address of every page of this version, by backend and page.
+		VT(VT(std::string)) addresses(backends.size(), VT(std::string)(site.pages.size()));
+
+		struct Task
+		{
+			size_t backend;
+			size_t page;
+		};
+
+		VT(Task) tasks;
+		for (size_t b = 0; b < backends.size(); ++b)
+		{
+			for (size_t p = 0; p < site.pages.size(); ++p)
+			{
+				auto last = previous[b].find(site.pages[p].name);
+
+				if (restructured || dirty.count(site.pages[p].name) != 0 || last == previous[b].end())
+					tasks.push_back({ b, p });
+				else
+					addresses[b][p] = last->second;
+			}
+		}
+
+		// Each page is stored as soon as it is rendered, so only the pages being rendered are in memory.
+		std::atomic<size_t> next_task{ 0 };
+		auto RenderPages = [&]()
+		{
+			for (size_t t = next_task++; t < tasks.size(); t = next_task++)
+			{
+				const Writer* backend = backends[tasks[t].backend];
+				addresses[tasks[t].backend][tasks[t].page] = store.Put(backend->Render(site.pages[tasks[t].page], site, crefs), backend->Extension());
+			}
+		};
+
+		VT(std::thread) renderers;
+		for (size_t r = 0; r < std::min<size_t>(std::max(1u, options.Stages().render), tasks.size()); ++r)
+		{
+			renderers.emplace_back(RenderPages);
+		}
+
+		for (auto& renderer : renderers)
+		{
+			renderer.join();
+		}
+
+		// Every file of this version's tree, relative to it, and its address.
+		std::vector<std::pair<std::string, std::string>> files;
+
+		for (size_t b = 0; b < backends.size(); ++b)
+		{
+			const Writer& backend = *backends[b];
+			const std::string tree_path = TreePath(backend);
+
+			previous[b].clear();
+			for (size_t p = 0; p < site.pages.size(); ++p)
+			{
+				if (addresses[b][p].empty())
+				{
+					failed = true;
+					continue;
+				}
+
+				previous[b][site.pages[p].name] = addresses[b][p];
+				files.emplace_back(tree_path + site.pages[p].name + backend.Extension(), addresses[b][p]);
+			}
+
+			// An index is about every page, so it is rendered for every version, and stored like a page.
+			MemorySink index;
+			if (!backend.WriteIndex(site, index, nullptr))
+				failed = true;
+
+			for (auto& written : index.Pages())
+			{
+				const std::string address = store.Put(written.second, std::filesystem::path(written.first).extension().string().c_str());
+				if (address.empty())
+					failed = true;
+				else
+					files.emplace_back(tree_path + written.first.substr(backend.OutputPath().length()), address);
+			}
+
+			for (const std::string& asset : backend.Assets())
+			{
+				std::string content;
+				if (!ReadFile(backend.OutputPath() + asset, content))
+				{
+					MLOG(Warning, "The " << backend.Name() << " asset " << backend.OutputPath() << asset << " cannot be read; version " << version.name << " is without it.");
+					continue;
+				}
+
+				const std::string address = store.Put(content, std::filesystem::path(asset).extension().string().c_str());
+				if (address.empty())
+					failed = true;
+				else
+					files.emplace_back(tree_path + asset, address);
+			}
+		}
+
+		std::sort(files.begin(), files.end());
+
+		// The tree is only links, so it is linked again from scratch; pages that no longer exist go with it.
+		const std::string tree = root + version.name + '/';
+		std::filesystem::remove_all(tree, error);
+
+		for (auto& file : files)
+		{
+			failed |= !store.Link(file.second, tree + file.first);
+		}
+
+		const double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		mapping += v != 0 ? ",\n" : "\n";
+		mapping += "{\"name\":" + JSON::Quote(version.name) + ",\"input\":" + JSON::Quote(version.input) + ",\"files\":[";
+		for (size_t f = 0; f < files.size(); ++f)
+		{
+			mapping += f != 0 ? ",\n" : "\n";
+			mapping += "{\"file\":" + JSON::Quote(files[f].first) + ",\"address\":" + JSON::Quote(files[f].second) + '}';
+		}
+		mapping += "\n]}";
+
+		report += v != 0 ? "," : "";
+		report += "{\"name\":" + JSON::Quote(version.name) + ",\"members\":" + std::to_string(all_mw.size()) + ",\"added\":" + std::to_string(changes.added.size())
+			+ ",\"removed\":" + std::to_string(changes.removed.size()) + ",\"changed\":" + std::to_string(changes.changed.size())
+			+ ",\"pages\":" + std::to_string(site.pages.size() * backends.size()) + ",\"rendered\":" + std::to_string(tasks.size())
+			+ ",\"files\":" + std::to_string(files.size()) + ",\"milliseconds\":" + std::to_string(milliseconds) + '}';
+
+		MLOG(Info, "Version " << version.name << ": " << all_mw.size() << " members; rendered " << tasks.size() << " of " << site.pages.size() * backends.size()
+			<< " pages in " << milliseconds << " ms.");
+
+		// The previous parse is only released now, as changes pointed into it.
+		previous_parameters = std::move(parameters);
+		previous_mw = std::move(all_mw);
+	}
+
+	mapping += "\n]\n}\n";
+
+	FileSink sink;
+	if (!sink.Write(root + "versions.json", mapping))
+	{
+		MLOG(Error, "Failed to write " << root << "versions.json. Maybe permissions?");
+		failed = true;
+	}
+
+	// A file a version could not be written with may still be used by it, so nothing is removed then.
+	size_t collected = 0;
+	if (!failed)
+	{
+		collected = store.Collect();
+
+		// Docs/Versions is what versions.json says it is: the trees of versions no longer written go too.
+		VT(std::filesystem::path) stale;
+		for (auto& entry : std::filesystem::directory_iterator(root, error))
+		{
+			const std::string name = entry.path().filename().string();
+			const bool written = std::any_of(versions.begin(), versions.end(), [&](const VersionInput& version) { return version.name == name; });
+
+			if (entry.is_directory(error) && name != "Store" && !written)
+				stale.push_back(entry.path());
+		}
+
+		for (const std::filesystem::path& tree : stale)
+		{
+			MLOG(Info, "Removing version " << tree.filename().string() << ", which is not in --versions.");
+			std::filesystem::remove_all(tree, error);
+		}
+	}
+
+	MLOG(Info, versions.size() << " versions: stored " << store.Stored() << " new files (" << store.StoredBytes() / 1024 << " KB), reused " << store.Deduplicated()
+		<< ", linked " << store.Links() << " and copied " << store.Copies() << " files, and removed " << collected << " unused files from the store.");
+
+	report += "],\"stored\":" + std::to_string(store.Stored()) + ",\"stored_bytes\":" + std::to_string(store.StoredBytes())
+		+ ",\"deduplicated\":" + std::to_string(store.Deduplicated()) + ",\"links\":" + std::to_string(store.Links())
+		+ ",\"copies\":" + std::to_string(store.Copies()) + ",\"collected\":" + std::to_string(collected) + '}';
+	RunReport::Set("versions", report);
+
+	return !failed;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "MMacros.h"
+
+class Writer;
+struct Options;
+
+/*
+* One version of MW to document, given to --versions as name=path.
+*/
+struct VersionInput
+{
+	// The directory of this version in Docs/Versions. E.g., 1.2.
+	std::string name;
+	// Its MW.xml.
+	std::string input;
+};
+
+/*
+* Writes the documentation of several versions of MW side by side, in one run, from each
+  version's MW.xml.
+*
+* Every version is a tree in Docs/Versions/<name>, laid out as Docs is, whose files are hard
+  links into a PageStore in Docs/Versions/Store. A page with the same content in several
+  versions is stored once.
+* Versions are written in the order given. Each is diffed against the one before it with
+  ApiDiff: if members were only changed, only the pages of their namespaces are rendered,
+  and every other page links to the file of the version before. Adding or removing a member
+  changes navigation and which crefs resolve, so then every page of the version is rendered,
+  and only the pages whose content changed are stored.
+* Docs/Versions/versions.json maps every file of every version to its address in the store,
+  for serving the versions without the links. Stored files no version uses are removed.
+*/
+class Versions
+{
+
+public:
+
+	/* Writes every version with every backend. Returns false if a file could not be written. */
+	static bool Generate(const VT(VersionInput)& versions, const VT(Writer*)& backends, const Options& options);
+
+	/* Parses name=path,name=path. False if a name is empty, repeated or not a directory name. */
+	static bool Parse(const std::string& list, VT(VersionInput)& versions);
+
+};
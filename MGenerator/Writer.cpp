@@ -1,349 +1,344 @@
-#include <fstream>
-#include <map>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <thread>
 
-#include "MMacros.h"
 #include "Writer.h"
-#include "MW.h"
-
-#if BUILD
-#include "Timer.h"
-#endif
-
-#define Q(s) "\""#s"\""
-
-#define HTML_HEADER(title) "<!DOCTYPE html><html lang=" \
-			Q(en) \
-			"><head>" \
-			"<title>" << title << " | MW Unity Namespace</title><link rel=" Q(stylesheet) " href=" \
-			Q(CSS/MWUnityNamespace.css) \
-			"><meta charset=" \
-			"UTF-8" \
-			"></head><body><div class=" Q(header) " id=" Q(top) ">" \
-			"MW UNITY NAMESPACE</div>" \
-
-#define HTML_END "</div></div></div></body></html>"
-
-/*
-* CSS styles to apply to html.
-*/
-
-/*
-* The div marking the beginning of the two column table.
-* The left column is the nav links with the complete MW
-  namespace and links to their XML tags.
-* The right column describes the fields/properties/functions
-  constructors and summaries of the respective namespace
-  function.
-*/
-constexpr const char* CSS_HOLDING_DIV = Q(width: 100%; display: table;);
-/*
-* The div marking the first and only row in the file.
-*/
-constexpr const char* CSS_INNER_DIV = Q(display: table-row);
-/*
-* The div defining the styles of the left column.
-*/
-constexpr const char* CSS_LEFT_COL_DIV = Q(width: 200px; display: table-cell;);
-/*
-* The div defining the styles of the right column.
-*/
-constexpr const char* CSS_RIGHT_COL_DIV = Q(display: table-cell;);
-/*
-* The CSS selector used for every link in the navbar.
-*/
-constexpr const char* CSS_NAV_LINKS = Q(navLinks);
-/*
-* The CSS selector used to define the style for namespace classes or
-  functions, depending on whether the namespace class is a part of
-  the root MW namespace.
-*/
-constexpr const char* CSS_HEADER_STYLE = Q(FuncTitle);
-/*
-* The CSS selector/s used to define the style for namespace classes.
-*/
-constexpr const char* CSS_CLASS_STYLE = Q(DefinedType C);
-/*
-* The CSS selector/s used to style the namespace class summary.
-*/
-constexpr const char* CSS_CLASS_SUMMARY_STYLE = Q(simplePara C);
-/*
-* The CSS selector used to style function summaries and parameter
-  definitions.
-*/
-constexpr const char* CSS_PARAGRAPH = Q(simplePara);
-/*
-* The CSS selector used to style names of function parameters.
-*/
-constexpr const char* CSS_PARAM_NAME = Q(ParamName);
-/*
-* The CSS selector used to style function parameters' descriptions.
-*/
-constexpr const char* CSS_PARAM_DESC = Q(ParamDesc);
-/*
-* The CSS selector used to style keywords for function summaries.
-*/
-constexpr const char* CSS_KEYWORD = Q(keyword);
-
-/*
-* HTML shorthand for writing tab spaces.
-*/
-constexpr const char* HTML_TAB = "&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;";
-
-#if WRITE_DEBUG_LINES
-#define DEBUG_WRITELINE << "<p style=" Q(color:white) ">" INTER_INJECT_TEXT(__LINE__) << "</p>"
-#define GET_LINE << " L" << __LINE__
-#else
-#define DEBUG_WRITELINE
-#define GET_LINE
-#endif
-
-#define INTER_INJECT_TEXT(text) << text GET_LINE
-#define INTER_INJECT_CLASS_DECORATIONS(decorations) "<pre class=" Q(C) " style=" Q(padding-right:25%;color:rgb(126, 252, 202);) ">" INTER_INJECT_TEXT(decorations) << "</pre>"
-#define INTER_INJECT_FUNCTION_DECORATIONS(decorations) "<br><pre style=" Q(padding-right:25%;color:rgb(126, 252, 202);font-weight:549) ">" INTER_INJECT_TEXT(decorations) << "</pre>"
-
-#define FMT_PARAM_PRIM_TYPE(type) "<span class=" Q(PrimitiveType) ">" + type + "</span>"
-#define FMT_PARAM_DEF_TYPE(type) "<span class=" Q(DefinedType) ">" + type + "</span>"
-#define FMT_PARAM_NAME(name) "<span class=" Q(FuncParamName) ">" + name + "</span>"
-#define FMT_PRIM_FUNC(type, name) FMT_PARAM_PRIM_TYPE(type) " " FMT_PARAM_NAME(name)
-#define FMT_DEF_FUNC(type, name) FMT_PARAM_DEF_TYPE(type) " " FMT_PARAM_NAME(name)
-
-#define HTML_HOLDING_DIV "<div style=" << CSS_HOLDING_DIV << "><div style=" << CSS_INNER_DIV << "><div style=" << CSS_LEFT_COL_DIV << ">" DEBUG_WRITELINE
-#define HTML_NAV_ENTRY(entry) "<div class=" << CSS_NAV_LINKS << "><a href=\"" << entry << ".html\">" << entry << "</a></div><br>" DEBUG_WRITELINE
-#define HTML_SUMMARY_START "</div><br><br><div style=" << CSS_RIGHT_COL_DIV << ">" DEBUG_WRITELINE
-#define HTML_CLASS_START(entry, summary, decorations) INTER_INJECT_CLASS_DECORATIONS(decorations) << "</pre><h1 class=" << CSS_CLASS_STYLE << ">" INTER_INJECT_TEXT(entry) << "</h1><br><p class=" << CSS_CLASS_SUMMARY_STYLE << ">" INTER_INJECT_TEXT(summary) << "</p>" DEBUG_WRITELINE
-#define HTML_SUMMARY_TITLE(title, decorations) INTER_INJECT_FUNCTION_DECORATIONS(decorations) << "<p class=" << CSS_HEADER_STYLE << ">" INTER_INJECT_TEXT(title) << "</p>" DEBUG_WRITELINE
-#define HTML_DECLARE_FUNCTION_PARAMS(title, params, decorations) INTER_INJECT_FUNCTION_DECORATIONS(decorations) << "<h1 class=" << CSS_HEADER_STYLE << ">" INTER_INJECT_TEXT(title) << " (" INTER_INJECT_TEXT(params) << ")</h1>" DEBUG_WRITELINE
-#define HTML_DECLARE_OPERATOR_OVERLOAD(overload, params, decorations) INTER_INJECT_FUNCTION_DECORATIONS(decorations) << "<br><h1 class" << CSS_HEADER_STYLE << ">" INTER_INJECT_TEXT(overload) INTER_INJECT_TEXT(params) << "</h1>" DEBUG_WRITELINE
-#define HTML_SUMMARY_ENTRY(entry) "<p class=" << CSS_PARAGRAPH << ">" INTER_INJECT_TEXT(entry) << "</p>" DEBUG_WRITELINE
-#define HTML_PARAM_ENTRY(var, desc) "<p class=" << CSS_PARAM_NAME << ">" INTER_INJECT_TEXT(var) << "</p><p class=" << CSS_PARAM_DESC << ">" << HTML_TAB INTER_INJECT_TEXT(desc) << "</p>" DEBUG_WRITELINE
-#define HTML_KEYWORD(keyword) "<p class=" << CSS_KEYWORD << ">" INTER_INJECT_TEXT(keyword) << "</p>" DEBUG_WRITELINE
-
-void Writer::Write(const VT(MW)& all_mw)
+#include "CrossReference.h"
+#include "Inline.h"
+#include "Log.h"
+#include "Manifest.h"
+#include "OutputSink.h"
+#include "Phase.h"
+#include "Pipeline.h"
+#include "RunReport.h"
+
+std::string Writer::Render(const Page& page, const Site& site, const CrossReference& crefs) const
 {
-	std::map<std::string, std::string> namespace_to_html;
+	PhaseScope render(EPhase::Render);
 
-#if EXEC_FROM_VS
-	const std::string HTML_PATH = "../Docs/HTML/";
-#else
-	const std::string HTML_PATH = "../../Docs/HTML/";
-#endif
+	std::ostringstream rendered;
+	RenderPage(rendered, page, site, crefs);
 
-	// Write/Create basic HTML file.
-	for (auto& n : all_mw)
+	return rendered.str();
+}
+
+bool Writer::WritePage(const Page& page, std::string&& content, OutputSink& sink, Manifest* manifest) const
+{
+	PhaseScope write(EPhase::Write);
+
+	const std::string output_path = OutputPath();
+
+	if (!sink.Write(output_path + page.name + Extension(), content))
 	{
-		if (namespace_to_html.find(n.mw_namespace) == namespace_to_html.end())
-		{
-			std::string new_file = HTML_PATH + n.mw_namespace + ".html";
-			namespace_to_html.insert({ n.mw_namespace, new_file });
+		MLOG(Error, "Failed to create " << Name() << " file at " << output_path << ". Maybe permissions?");
+		MLOG(Error, "Also probably check the EXEC_FROM_VS macro...");
+		return false;
+	}
 
-			std::ofstream html_file(new_file);
+	MLOG(Verbose, page.name << Extension() << " created.");
 
-			html_file << HTML_HEADER(n.mw_namespace) << HTML_HOLDING_DIV;
+	// Pages are hashed on another thread while the next page is written.
+	if (manifest)
+		manifest->Add(page.name + Extension(), { "MW." + page.name }, std::move(content));
 
-#if BUILD
-			if (html_file.fail())
-			{
-				std::cout << "Failed to create HTML file at " << HTML_PATH << ". Maybe permissions?\n";
-				std::cout << "Also probably check the EXEC_FROM_VS macro...\n";
-				std::cout << "Writing to HTML file/s has been stopped!\n";
-				return;
-			}
-#if WRITE_CREATION_MESSAGES
-			else
-			{
-				std::cout << n.mw_namespace << ".html" << " created.\n";
-			}
-#endif // WRITE_CREATION_MESSAGES
-#endif // BUILD
+	return true;
+}
 
-			html_file.close();
-		}
+bool Writer::WriteChangelog(const ApiChanges& changes, const CrossReference& crefs, OutputSink& sink) const
+{
+	std::ostringstream rendered;
+
+	{
+		PhaseScope render(EPhase::Render);
+		RenderChangelog(rendered, changes, crefs);
 	}
 
-	// Write all namespace links.
-	for (auto& ns : namespace_to_html)
+	PhaseScope write(EPhase::Write);
+
+	if (!sink.Write(OutputPath() + "Changelog" + Extension(), rendered.str()))
 	{
-		for (auto& nth : namespace_to_html)
-		{
-			std::ofstream html(nth.second, std::ios_base::app);
+		MLOG(Error, "Failed to create the " << Name() << " changelog at " << OutputPath() << ". Maybe permissions?");
+		return false;
+	}
 
-			html << HTML_NAV_ENTRY(ns.first);
+	MLOG(Info, Name() << ": Changelog" << Extension() << " created.");
 
-			html.close();
+	return true;
+}
+
+Site Writer::Paginate(const VT(MW)& all_mw)
+{
+	Site site;
+
+	// Every namespace is already contiguous; a page ends where the namespace changes.
+	for (size_t begin = 0, end = 0; begin < all_mw.size(); begin = end)
+	{
+		while (end < all_mw.size() && all_mw[end].mw_namespace == all_mw[begin].mw_namespace)
+		{
+			++end;
 		}
+
+		site.pages.push_back({ all_mw[begin].mw_namespace, all_mw.data() + begin, all_mw.data() + end });
 	}
 
-	// Prepare the right column.
-	for (auto& namespace_file : namespace_to_html)
+	site.namespaces.Build(site.pages);
+
+	return site;
+}
+
+void Writer::WriteAll(const VT(MW)& all_mw, const VT(Writer*)& backends, const PipelineConfig& pipeline, OutputSink& sink, const std::string& subtree, const Shard& shard)
+{
+	// Resolve every <see cref="..."/> once, before any page is written.
+	// Every backend only reads from crefs and site.
+	CrossReference crefs;
+	crefs.Build(all_mw);
+
+	const Site site = Paginate(all_mw);
+	const NamespaceTrie& namespaces = site.namespaces;
+
+	const size_t scope = subtree.length() != 0 ? namespaces.Find(subtree) : NamespaceTrie::Root();
+	if (scope == NamespaceTrie::NONE)
 	{
-		std::ofstream html(namespace_file.second, std::ios_base::app);
+		MLOG(Error, "There is no namespace " << subtree << " to write.");
+		return;
+	}
 
-		html << HTML_SUMMARY_START;
+	// One task per subtree directly below scope, and one for scope's own page, so that
+	// every branch renders independently of the others.
+	VT(VT(size_t)) subtrees;
 
-		html.close();
+	if (namespaces[scope].page != NamespaceTrie::NONE)
+		subtrees.push_back({ namespaces[scope].page });
+
+	for (size_t child : namespaces[scope].children)
+	{
+		subtrees.push_back(namespaces.Pages(child));
 	}
 
-	for (auto& mw : all_mw)
+	if (!shard.IsWhole())
 	{
-		std::ofstream html(namespace_to_html[mw.mw_namespace], std::ios_base::app);
-		if (mw.mw_name.length() == 0)
+		// Every page is still in site, for navigation, but only this shard's pages are rendered.
+		const VT(unsigned) assignment = Shard::Assign(site, shard.count);
+
+		size_t pages = 0, members = 0;
+		for (auto& pages_of_subtree : subtrees)
 		{
-			html << HTML_CLASS_START(
-				(mw.mw_class.length() != 0
-					? mw.mw_class
-					: mw.mw_namespace)
-				, mw.summary, GetDecorations(mw.decorations));
+			pages_of_subtree.erase(std::remove_if(pages_of_subtree.begin(), pages_of_subtree.end(), [&](size_t page) { return assignment[page] != shard.index; }), pages_of_subtree.end());
+
+			for (size_t page : pages_of_subtree)
+			{
+				++pages;
+				members += site.pages[page].last - site.pages[page].first;
+			}
 		}
-		else
+
+		subtrees.erase(std::remove_if(subtrees.begin(), subtrees.end(), [](const VT(size_t)& pages_of_subtree) { return pages_of_subtree.empty(); }), subtrees.end());
+
+		MLOG(Info, "Shard " << shard.index + 1 << '/' << shard.count << ": " << pages << " of " << site.pages.size() << " pages, " << members << " of " << all_mw.size() << " members.");
+		RunReport::Set("shard", "{\"shard\":" + std::to_string(shard.index + 1) + ",\"shards\":" + std::to_string(shard.count)
+			+ ",\"pages\":" + std::to_string(pages) + ",\"members\":" + std::to_string(members) + '}');
+	}
+
+	// A manifest only describes a whole output directory on disk, so it is not written when
+	// only a subtree is, or when nothing is written to disk.
+	const bool partial = scope != NamespaceTrie::Root();
+	VT(std::unique_ptr<Manifest>) manifests;
+
+	for (Writer* backend : backends)
+	{
+		if (sink.IsPersistent())
 		{
-			if (mw.function_parameters_type.size() == 0)
+			std::error_code ignored;
+			std::filesystem::create_directories(backend->OutputPath(), ignored);
+		}
+
+		manifests.emplace_back(partial || !sink.IsPersistent() ? nullptr : new Manifest(backend->OutputPath()));
+	}
+
+	// Pages stream from the render stage to the write stage as soon as they are rendered.
+	struct RenderedPage
+	{
+		size_t backend;
+		size_t page;
+		std::string content;
+	};
+
+	BoundedQueue<RenderedPage> rendered(pipeline.queue_depth);
+
+	const size_t tasks = backends.size() * subtrees.size();
+	std::atomic<size_t> next_task{ 0 };
+
+	auto RenderSubtrees = [&]()
+	{
+		for (size_t task = next_task++; task < tasks; task = next_task++)
+		{
+			const size_t backend = task / subtrees.size();
+
+			for (size_t page : subtrees[task % subtrees.size()])
 			{
-				if (mw.mw_type == MEMBER)
-				{
-					if (mw.implicit.length() == 0)
-					{
-						// A function.
-						// Because this function_parameters_type.size == 0, this has no parameters.
-						// Write the name of the function with empty brackets.
-						html << HTML_DECLARE_FUNCTION_PARAMS(mw.mw_name, "", GetDecorations(mw.decorations));
-					}
-					else
-					{
-						// An implicit operator.
-						html << HTML_DECLARE_FUNCTION_PARAMS(mw.implicit, "", GetDecorations(mw.decorations));
-					}
-
-					// If there is a summary, write it here.
-					if (mw.summary.length() != 0)
-						html << HTML_KEYWORD("Summary:") << HTML_SUMMARY_ENTRY(mw.summary);
-
-					// If there are remarks, write it here.
-					if (mw.remarks.length() != 0)
-						html << HTML_KEYWORD("Remarks:") << HTML_SUMMARY_ENTRY(mw.remarks);
-
-					// If there is a return value, write it here.
-					if (mw.returns.length() != 0)
-						html << HTML_KEYWORD("Returns:") << HTML_SUMMARY_ENTRY(mw.returns);
-				}
-				else
-				{
-					bool no_class = mw.mw_class.length() == 0;
-					// Not a function.
-					// Write whatever this is normally.
-					if (no_class ^ mw.mw_type == FIELD ^ mw.mw_type == PROPERTY)
-					{
-						html << HTML_SUMMARY_TITLE(mw.mw_name, GetDecorations(mw.decorations)) << HTML_SUMMARY_ENTRY(mw.summary);
-
-						if (mw.remarks.length() != 0)
-							html << HTML_SUMMARY_ENTRY(mw.remarks);
-					}
-					else
-					{
-						html << HTML_CLASS_START(mw.mw_name, mw.summary + "<br>" + mw.remarks, GetDecorations(mw.decorations));
-					}
-				}
+				rendered.Push({ backend, page, backends[backend]->Render(site.pages[page], site, crefs) });
 			}
-			else
+		}
+	};
+
+	VT(std::atomic<bool>) failed(backends.size());
+
+	auto WritePages = [&]()
+	{
+		RenderedPage page;
+
+		while (rendered.Pop(page))
+		{
+			// Once a page of a backend could not be written, the rest of its pages are dropped.
+			if (failed[page.backend])
+				continue;
+
+			if (!backends[page.backend]->WritePage(site.pages[page.page], std::move(page.content), sink, manifests[page.backend].get()))
 			{
-				std::string param;
-				auto size_of_name = mw.function_parameters_name.size();
-
-				// Writing function parameter types.
-				std::string generics = "TYUMNKR";
-				for (int i = 0, generic_count = 0; i < size_of_name; ++i)
-				{
-					std::string param_type;
-					std::string param_name;
-
-					// If the type is just a standalone 'T', then we know it's a generic.
-					// Replace the genric 'T' with the std::string generics using generic_count.
-					if (mw.function_parameters_type[i].length() == 1 && mw.function_parameters_type[i][0] == 'T')
-					{
-						param_type = generics[generic_count++];
-					}
-					else
-					{
-						// For some reason, there may be a generic parameter marked by two T's
-						// (TT), where in reality, they reference only T.
-						// If this is the case, only add one T, the first T, to the params.
-						if (mw.function_parameters_type[i] == "TT")
-						{
-							param_type = mw.function_parameters_type[i][0];
-						}
-						else
-						{
-							// Otherwise, add the type as normal.
-							param_type = mw.function_parameters_type[i];
-						}
-					}
-
-					param_name += mw.function_parameters_name[i];
-
-					if (i != size_of_name - 1)
-						param_name += ", ";
-
-					param += (param_type.length() && std::isupper(param_type[0]))
-						? FMT_DEF_FUNC(param_type, param_name)
-						: FMT_PRIM_FUNC(param_type, param_name);
-				}
-
-				// Write the name of the function.
-				html << HTML_DECLARE_FUNCTION_PARAMS(mw.mw_name, param, GetDecorations(mw.decorations));
-
-				// If there is a summary, write it here.
-				if (mw.summary.length() != 0)
-					html << HTML_KEYWORD("Summary:") << HTML_SUMMARY_ENTRY(mw.summary);
-
-				// If there are remarks, write it here.
-				if (mw.remarks.length() != 0)
-					html << HTML_KEYWORD("Remarks:") << HTML_SUMMARY_ENTRY(mw.remarks);
-
-				// Write the summaries for the parameters (if any).
-				for (int i = 0; i < size_of_name; ++i)
-				{
-					bool has_description = mw.function_parameters_desc[i].length() != 0;
-
-					if (i == 0 && has_description)
-						html << HTML_KEYWORD("Params:");
-
-					if (has_description)
-					{
-						html << HTML_PARAM_ENTRY(mw.function_parameters_name[i] + ": ", mw.function_parameters_desc[i]);
-					}
-				}
-
-				// If there is a return value, write it here.
-				if (mw.returns.length() != 0)
-					html << HTML_KEYWORD("Returns:") << HTML_SUMMARY_ENTRY(mw.returns);
+				failed[page.backend] = true;
+				MLOG(Error, "Writing to " << backends[page.backend]->Name() << " file/s has been stopped!");
 			}
 		}
+	};
+
+	const size_t renderers_count = std::min<size_t>(std::max(1u, pipeline.render), tasks);
+
+	const auto start = std::chrono::steady_clock::now();
+	const size_t files_before = sink.Files(), bytes_before = sink.Bytes();
 
-		html.close();
+	VT(std::thread) renderers, writers;
+	for (size_t w = 0; w < renderers_count; ++w)
+	{
+		renderers.emplace_back(RenderSubtrees);
 	}
 
-	// End basic HTML file.
-	for (auto& nth : namespace_to_html)
+	for (unsigned w = 0; w < std::max(1u, pipeline.write); ++w)
 	{
-		std::ofstream html(nth.second, std::ios_base::app);
+		writers.emplace_back(WritePages);
+	}
 
-		html << HTML_END;
+	for (auto& renderer : renderers)
+	{
+		renderer.join();
+	}
 
-		html.close();
+	rendered.Close();
+	for (auto& writer : writers)
+	{
+		writer.join();
 	}
+
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	Pipeline::Record("render", "write", std::max(1u, pipeline.write), rendered.Stats());
+
+	ReportThroughput(sink, sink.Files() - files_before, sink.Bytes() - bytes_before, seconds);
+
+	for (size_t b = 0; b < backends.size(); ++b)
+	{
+		// Every shard has the same site, so only the first writes the index, and only one fragment lists it.
+		if (!failed[b] && shard.index == 0 && !backends[b]->WriteIndex(site, sink, manifests[b].get()))
+			MLOG(Error, "Failed to write the " << backends[b]->Name() << " index to " << backends[b]->OutputPath() << ". Maybe permissions?");
+
+		backends[b]->Summarise();
+
+		if (manifests[b] && !shard.IsWhole())
+			manifests[b]->FinishFragment(shard.FragmentName(), backends[b]->Name());
+		else if (manifests[b])
+			manifests[b]->Finish(backends[b]->Name());
+		else if (partial)
+			MLOG(Info, backends[b]->Name() << ": wrote MW." << namespaces[scope].path << " only; the manifest is unchanged.");
+	}
+
+	crefs.Report();
 }
 
+void Writer::ReportThroughput(const OutputSink& sink, const size_t files, const size_t bytes, const double seconds)
+{
+	const double megabytes = bytes / (1024.0 * 1024.0);
+	const double pages_per_second = seconds > 0 ? files / seconds : 0;
+	const double megabytes_per_second = seconds > 0 ? megabytes / seconds : 0;
+
+	// With the null sink, this is how fast pages are rendered.
+	MLOG(Info, "Wrote " << files << " pages, " << std::fixed << std::setprecision(2) << megabytes << " MB, to the " << sink.Name() << " sink in "
+		<< seconds * 1000 << " ms: " << std::setprecision(0) << pages_per_second << " pages/s, " << std::setprecision(2) << megabytes_per_second << " MB/s.");
+
+	RunReport::Set("sink", "{\"sink\":\"" + std::string(sink.Name()) + "\",\"files\":" + std::to_string(files)
+		+ ",\"bytes\":" + std::to_string(bytes) + ",\"seconds\":" + std::to_string(seconds)
+		+ ",\"pages_per_second\":" + std::to_string(pages_per_second)
+		+ ",\"megabytes_per_second\":" + std::to_string(megabytes_per_second) + '}');
+}
+
+std::string Writer::FormatText(std::string_view text, const CrossReference& crefs) const
+{
+	std::string formatted;
+
+	Inline::ForEach(text,
+		[&](const char* raw, size_t length) { AppendText(formatted, raw, length); },
+		[&](const InlineElement& element) { formatted += FormatInline(element, crefs); });
+
+	return formatted;
+}
+
+std::string Writer::GetSeeAlso(const VT(std::string)& see_also, const CrossReference& crefs, const char* separator) const
+{
+	std::string links;
+
+	for (size_t i = 0; i < see_also.size(); ++i)
+	{
+		if (i != 0)
+			links += separator;
+
+		InlineElement element;
+		element.kind = EInline::SeeAlso;
+		element.target = see_also[i];
+
+		links += FormatInline(element, crefs);
+	}
 
-std::string Writer::GetDecorations(const VT(std::string)& decorations)
+	return links;
+}
+
+VT(std::string) Writer::GetParameterTypes(const MW& mw)
 {
-	if (decorations.empty())
-		return std::string();
+	const size_t size_of_name = mw.name_count;
 
-	std::string decor = "<br>";
+	VT(std::string) param_types;
+	param_types.reserve(size_of_name);
 
-	for (size_t i = 0; i < decorations.size(); ++i)
+	std::string generics = "TYUMNKR";
+	for (size_t i = 0, generic_count = 0; i < size_of_name; ++i)
 	{
-		decor += decorations[i] + " ";
+		// Empty if there are more <param> tags than parameters in the signature.
+		const std::string_view type = mw.ParameterType(i);
+
+		// If the type is just a standalone 'T', then we know it's a generic.
+		// Replace the genric 'T' with the std::string generics using generic_count.
+		if (type.length() == 1 && type[0] == 'T')
+		{
+			param_types.emplace_back(1, generics[generic_count++]);
+		}
+		else
+		{
+			// For some reason, there may be a generic parameter marked by two T's
+			// (TT), where in reality, they reference only T.
+			// If this is the case, only add one T, the first T, to the params.
+			if (type == "TT")
+			{
+				param_types.emplace_back(1, type[0]);
+			}
+			else
+			{
+				// Otherwise, add the type as normal.
+				param_types.emplace_back(type);
+			}
+		}
 	}
 
-	return decor;
+	return param_types;
 }
@@ -1,20 +1,131 @@
 #pragma once
 
-#include <iostream>
+#include <ostream>
+#include <string>
 #include <vector>
 
 #include "MW.h"
 #include "MMacros.h"
+#include "NamespaceTrie.h"
+#include "Shard.h"
 
+class CrossReference;
+class Manifest;
+class OutputSink;
+struct ApiChanges;
+struct PipelineConfig;
+struct InlineElement;
+
+/*
+* Every MW that belongs on one page of documentation.
+*/
+struct Page
+{
+	// The namespace of this page. E.g., Math.Magic.
+	std::string name;
+
+	// The MW on this page; a contiguous range of the sorted MW, ordered by class, name and
+	// arity so that overloads are next to each other.
+	const MW* first;
+	const MW* last;
+
+	const MW* begin() const { return first; }
+	const MW* end() const { return last; }
+};
+
+/*
+* Every page in a run, and the namespace tree they form.
+*/
+struct Site
+{
+	// Sorted by name.
+	VT(Page) pages;
+	NamespaceTrie namespaces;
+};
+
+/*
+* An output backend. A Writer renders the in-memory MW records into pages of one
+  format. Every backend is driven from the same records, so adding a format does
+  not need another parse of MW.xml.
+*/
 class Writer
 {
 
 public:
 
-	static void Write(const VT(MW)& all_mw);
+	virtual ~Writer() {}
+
+	/* The name of this format. E.g., HTML. */
+	virtual const char* Name() const = 0;
+	/* The extension of every page, including the '.'. */
+	virtual const char* Extension() const = 0;
+	/* The directory pages are written to, relative to the working directory. */
+	virtual std::string OutputPath() const = 0;
+
+	/* Renders a single page. site is every page in this run, for navigation. */
+	virtual void RenderPage(std::ostream& out, const Page& page, const Site& site, const CrossReference& crefs) const = 0;
+
+	/* Renders page, one of site.pages, to a string. */
+	std::string Render(const Page& page, const Site& site, const CrossReference& crefs) const;
+
+	/*
+	* Writes the rendered content of page to sink, adding it to manifest if it is not nullptr.
+	* Returns false if the page could not be written.
+	*/
+	bool WritePage(const Page& page, std::string&& content, OutputSink& sink, Manifest* manifest) const;
+
+	/* Renders the changes between two versions of MW.xml. Links resolve against crefs, the newer version. */
+	virtual void RenderChangelog(std::ostream& out, const ApiChanges& changes, const CrossReference& crefs) const = 0;
+
+	/* Renders and writes changes to Changelog in OutputPath(), through sink. Returns false if it could not be written. */
+	bool WriteChangelog(const ApiChanges& changes, const CrossReference& crefs, OutputSink& sink) const;
+
+	/* Called once every page has been written, to report anything particular to this format. */
+	virtual void Summarise() const {}
+
+	/*
+	* Writes any file about every page of site, rather than one page, such as an index, adding
+	  it to manifest if it is not nullptr. Returns false if it could not be written.
+	*/
+	virtual bool WriteIndex(const Site&, OutputSink&, Manifest*) const { return true; }
+
+	/* Files every page needs that are not rendered, such as stylesheets, relative to OutputPath(). */
+	virtual VT(std::string) Assets() const { return {}; }
+
+	/* Splits all_mw, sorted by Reader, into pages, one per namespace, and builds their NamespaceTrie. */
+	static Site Paginate(const VT(MW)& all_mw);
+
+	/*
+	* Renders all_mw with every backend through the render and write stages of pipeline.
+	* Every top-level namespace subtree of every backend is a separate render task, and each
+	  page is written to sink as soon as it is rendered.
+	* Manifests are only written for a FileSink.
+	* If subtree is not empty, only the pages at or below that namespace are written. E.g., MW.Math.
+	* If shard is not whole, only the pages Shard::Assign gives it are written, with a fragment
+	  of each manifest instead of the manifest.
+	*/
+	static void WriteAll(const VT(MW)& all_mw, const VT(Writer*)& backends, const PipelineConfig& pipeline, OutputSink& sink, const std::string& subtree = "", const Shard& shard = Shard());
+
+protected:
+
+	/*
+	* Formats text read from MW.xml: plain text is escaped with AppendText and inline
+	  elements are replaced with this format's markup.
+	*/
+	std::string FormatText(std::string_view text, const CrossReference& crefs) const;
+	virtual std::string FormatInline(const InlineElement& element, const CrossReference& crefs) const = 0;
+
+	/* Appends raw text from MW.xml, with its entities untranslated, to out in this format. */
+	virtual void AppendText(std::string& out, const char* raw, const size_t length) const = 0;
+
+	/* The formatted links of every <seealso> of an MW, separated by separator. */
+	std::string GetSeeAlso(const VT(std::string)& see_also, const CrossReference& crefs, const char* separator) const;
+
+	/* The display type of every named parameter of mw, with generic T's replaced by T, Y, U, ... */
+	static VT(std::string) GetParameterTypes(const MW& mw);
 
 private:
 
-	static std::string GetDecorations(const VT(std::string)& decorations);
+	/* Logs the pages and bytes written to sink per second, and sets the sink section of the run report. */
+	static void ReportThroughput(const OutputSink& sink, const size_t files, const size_t bytes, const double seconds);
 };
-